@@ -5,6 +5,8 @@
 ========================================================================*/
 
 #include "AefDeepSync.h"
+#include "AefPharusTrackAccessor.h"
+#include "AefDeepSyncSyntheticServer.h"
 
 #define LOCTEXT_NAMESPACE "FAefDeepSyncModule"
 
@@ -16,6 +18,10 @@ void FAefDeepSyncModule::StartupModule()
 void FAefDeepSyncModule::ShutdownModule()
 {
 	// Module cleanup. UDeepSyncSubsystem is auto-destroyed by GameInstance.
+	FAefPharusTrackAccessor::ResetCache();
+#if !UE_BUILD_SHIPPING
+	FAefDeepSyncSyntheticServer::ShutdownConsoleInstance();
+#endif
 }
 
 #undef LOCTEXT_NAMESPACE
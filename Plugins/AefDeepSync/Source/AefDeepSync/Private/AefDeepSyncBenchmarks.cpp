@@ -0,0 +1,1190 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Benchmarks
+
+   Headless checks of plugin hot paths with synthetic data, as automation
+   tests (fail on a broken result) and as console commands with
+   arguments. No server, wearables or Pharus tracker needed. Development
+   builds only, nothing of this is compiled into Shipping.
+
+   USAGE:
+   UnrealEditor-Cmd <Project> -game -nullrhi -ExecCmds="Automation RunTests AefDeepSync.Bench" -TestExit="Automation Test Queue Empty"
+   UnrealEditor-Cmd <Project> -nullrhi -ExecCmds="AefDeepSync.Bench.ZoneHash 4000 400, Quit"
+   UnrealEditor-Cmd <Project> -game -nullrhi -ExecCmds="AefDeepSync.Bench.All, Quit"
+========================================================================*/
+
+#include "AefDeepSyncTypes.h"
+#include "AefDeepSyncSubsystem.h"
+#include "AefDeepSyncManager.h"
+#include "AefDeepSyncSyntheticServer.h"
+#include "AefDeepSyncCommandEncoder.h"
+#include "AefDeepSyncEffects.h"
+#include "AefPharusDeepSyncZoneActor.h"
+#include "AefZoneSpatialHash.h"
+#include "AefZoneAssignmentSolver.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/AutomationTest.h"
+#include "Engine/Engine.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+//--------------------------------------------------------------------------------
+// Helpers
+//--------------------------------------------------------------------------------
+
+static int32 GetBenchArg(const TArray<FString>& Args, int32 Index, int32 Default)
+{
+	return Args.IsValidIndex(Index) ? FMath::Max(1, FCString::Atoi(*Args[Index])) : Default;
+}
+
+//--------------------------------------------------------------------------------
+// Zone Spatial Hash
+//--------------------------------------------------------------------------------
+
+/**
+ * Synthetic tracks vs. a grid of sync zones.
+ * Verifies hash results against brute force and reports cost per track.
+ */
+static bool RunZoneHashBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumTracks = GetBenchArg(Args, 0, 4000);
+	const int32 NumZones = GetBenchArg(Args, 1, 400);
+	const int32 Iterations = 100;
+
+	// Zones on a grid: 100cm radius, 300cm spacing
+	const int32 ZonesPerRow = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(NumZones)));
+	const float Spacing = 300.0f;
+	TArray<FVector2D> Centers;
+	TArray<float> Radii;
+	for (int32 i = 0; i < NumZones; ++i)
+	{
+		Centers.Add(FVector2D((i % ZonesPerRow) * Spacing, (i / ZonesPerRow) * Spacing));
+		Radii.Add(100.0f);
+	}
+
+	// Tracks spread over the whole zone area
+	FRandomStream Random(1234);
+	const float Extent = ZonesPerRow * Spacing;
+	TArray<FVector2D> Tracks;
+	for (int32 i = 0; i < NumTracks; ++i)
+	{
+		Tracks.Add(FVector2D(Random.FRandRange(-Spacing, Extent), Random.FRandRange(-Spacing, Extent)));
+	}
+
+	FAefZoneSpatialHash Hash;
+	const double BuildStart = FPlatformTime::Seconds();
+	Hash.Build(Centers, Radii);
+	const double BuildTime = FPlatformTime::Seconds() - BuildStart;
+
+	// Correctness: hash must report exactly the zones brute force finds
+	int32 Mismatches = 0;
+	int32 Occupied = 0;
+	TArray<int32> HashZones;
+	TArray<int32> BruteZones;
+	for (const FVector2D& Track : Tracks)
+	{
+		HashZones.Reset();
+		BruteZones.Reset();
+		Hash.ForEachZoneAt(Track, [&HashZones](int32 ZoneIndex) { HashZones.Add(ZoneIndex); });
+		for (int32 ZoneIndex = 0; ZoneIndex < NumZones; ++ZoneIndex)
+		{
+			if (FVector2D::DistSquared(Track, Centers[ZoneIndex]) <= static_cast<double>(Radii[ZoneIndex]) * Radii[ZoneIndex])
+			{
+				BruteZones.Add(ZoneIndex);
+			}
+		}
+		HashZones.Sort();
+		Mismatches += (HashZones != BruteZones) ? 1 : 0;
+		Occupied += BruteZones.Num();
+	}
+
+	// Timing: hash lookup vs. tracks x zones
+	int64 Hits = 0;
+	double Start = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (const FVector2D& Track : Tracks)
+		{
+			Hash.ForEachZoneAt(Track, [&Hits](int32) { ++Hits; });
+		}
+	}
+	const double HashTime = FPlatformTime::Seconds() - Start;
+
+	Start = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (const FVector2D& Track : Tracks)
+		{
+			for (int32 ZoneIndex = 0; ZoneIndex < NumZones; ++ZoneIndex)
+			{
+				Hits += FVector2D::DistSquared(Track, Centers[ZoneIndex]) <= 10000.0 ? 1 : 0;
+			}
+		}
+	}
+	const double BruteTime = FPlatformTime::Seconds() - Start;
+
+	const double TrackOps = static_cast<double>(NumTracks) * Iterations;
+	UE_LOG(LogAefDeepSync, Display, TEXT("Bench.ZoneHash: %d tracks, %d zones, cell=%.0fcm, build=%.3fms, occupied=%d, mismatches=%d"),
+		NumTracks, NumZones, Hash.GetCellSize(), BuildTime * 1000.0, Occupied, Mismatches);
+	UE_LOG(LogAefDeepSync, Display, TEXT("Bench.ZoneHash: hash=%.1f ns/track, brute force=%.1f ns/track (%.2fms per tick for all tracks) [%lld]"),
+		HashTime * 1e9 / TrackOps, BruteTime * 1e9 / TrackOps, HashTime * 1000.0 / Iterations, Hits);
+
+	if (Mismatches > 0)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.ZoneHash: FAILED - %d tracks with wrong zone occupancy"), Mismatches);
+	}
+	return Mismatches == 0;
+}
+
+static FAutoConsoleCommand GAefBenchZoneHashCommand(
+	TEXT("AefDeepSync.Bench.ZoneHash"),
+	TEXT("Zone spatial hash vs. brute force with synthetic tracks. Args: [NumTracks=4000] [NumZones=400]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) { RunZoneHashBenchmark(Args); }));
+
+//--------------------------------------------------------------------------------
+// Zone Assignment
+//--------------------------------------------------------------------------------
+
+/**
+ * Contending zones packed at an entrance, every zone sees many tracks.
+ * Compares the global solver against per-zone greedy picks and reports time per solve.
+ */
+static bool RunZoneAssignmentBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumZones = GetBenchArg(Args, 0, 50);
+	const int32 NumTracks = GetBenchArg(Args, 1, 200);
+	const int32 Iterations = 200;
+	const double Forbidden = FAefZoneAssignmentSolver::ForbiddenCost;
+
+	// Same cost model as the subsystem: normalized distance minus normalized dwell, ~30% of pairs not in the zone
+	FRandomStream Random(1234);
+	TArray<double> Costs;
+	Costs.SetNumUninitialized(NumZones * NumTracks);
+	for (double& Cost : Costs)
+	{
+		Cost = Random.FRand() < 0.3f ? Forbidden : Random.FRand() - Random.FRandRange(0.0f, 1.5f);
+	}
+
+	FAefZoneAssignmentSolver Solver;
+	TArray<int32> Assignment;
+	double TotalCost = Solver.Solve(Costs, NumZones, NumTracks, Assignment);
+
+	// Correctness: every track used at most once, no forbidden pair
+	int32 Assigned = 0;
+	int32 Errors = 0;
+	TSet<int32> UsedTracks;
+	for (int32 Row = 0; Row < NumZones; ++Row)
+	{
+		const int32 Col = Assignment[Row];
+		if (Col == INDEX_NONE) continue;
+
+		++Assigned;
+		bool bAlreadyUsed = false;
+		UsedTracks.Add(Col, &bAlreadyUsed);
+		Errors += (bAlreadyUsed || Costs[Row * NumTracks + Col] >= Forbidden) ? 1 : 0;
+	}
+
+	// Reference: zones decide in order, each takes its cheapest free track
+	double GreedyCost = 0.0;
+	int32 GreedyAssigned = 0;
+	TArray<bool> GreedyUsed;
+	GreedyUsed.Init(false, NumTracks);
+	for (int32 Row = 0; Row < NumZones; ++Row)
+	{
+		int32 BestCol = INDEX_NONE;
+		for (int32 Col = 0; Col < NumTracks; ++Col)
+		{
+			const double Cost = Costs[Row * NumTracks + Col];
+			if (!GreedyUsed[Col] && Cost < Forbidden && (BestCol == INDEX_NONE || Cost < Costs[Row * NumTracks + BestCol]))
+			{
+				BestCol = Col;
+			}
+		}
+		if (BestCol != INDEX_NONE)
+		{
+			GreedyUsed[BestCol] = true;
+			GreedyCost += Costs[Row * NumTracks + BestCol];
+			++GreedyAssigned;
+		}
+	}
+
+	// Timing
+	const double Start = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		TotalCost = Solver.Solve(Costs, NumZones, NumTracks, Assignment);
+	}
+	const double SolveTime = (FPlatformTime::Seconds() - Start) / Iterations;
+
+	UE_LOG(LogAefDeepSync, Display, TEXT("Bench.ZoneAssignment: %d zones, %d tracks, assigned=%d (greedy %d), cost=%.3f (greedy %.3f), errors=%d"),
+		NumZones, NumTracks, Assigned, GreedyAssigned, TotalCost, GreedyCost, Errors);
+	UE_LOG(LogAefDeepSync, Display, TEXT("Bench.ZoneAssignment: %.1f us per solve"), SolveTime * 1e6);
+
+	if (Errors > 0 || Assigned < GreedyAssigned || (Assigned == GreedyAssigned && TotalCost > GreedyCost + KINDA_SMALL_NUMBER))
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.ZoneAssignment: FAILED - assignment invalid or worse than greedy"));
+		return false;
+	}
+	return true;
+}
+
+static FAutoConsoleCommand GAefBenchZoneAssignmentCommand(
+	TEXT("AefDeepSync.Bench.ZoneAssignment"),
+	TEXT("Global zone/track assignment solver vs. per-zone greedy. Args: [NumZones=50] [NumTracks=200]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) { RunZoneAssignmentBenchmark(Args); }));
+
+//--------------------------------------------------------------------------------
+// Pipeline Benchmarks
+//--------------------------------------------------------------------------------
+
+// Heap the measured run keeps, counted by LLM (-llm) under its own tag, GMalloc is left alone
+LLM_DEFINE_TAG(AefDeepSyncBench);
+
+/** Bytes currently held under the benchmark tag, -1 without LLM */
+static int64 GetBenchHeapBytes()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	if (FLowLevelMemTracker::IsEnabled())
+	{
+		FLowLevelMemTracker& Tracker = FLowLevelMemTracker::Get();
+		Tracker.UpdateStatsPerFrame();
+		return Tracker.GetTagAmountForTracker(ELLMTracker::Default, FName(TEXT("AefDeepSyncBench")), ELLMTagSet::None, UE::LLM::ESizeParams::Default);
+	}
+#endif
+	return -1;
+}
+
+/**
+ * Headless benchmarks of the receive, dispatch, maintenance, zone and command paths.
+ * Run against the game instance's subsystem (DeepSync must be stopped), all
+ * benchmark wearables, links and actors are removed afterwards.
+ *
+ * Every benchmark runs once to warm up, then once measured, and reports one JSON line:
+ * {"bench":"Ingest","ops":100000,"ns_per_op":812.4,"heap_bytes_per_op":0.00,...}
+ * Lines are logged with a "BENCH " prefix and appended to Saved/AefDeepSync/Benchmarks.jsonl.
+ * Every Run function returns false if the result is wrong, timings are compared between runs.
+ */
+class FAefDeepSyncBenchmarks
+{
+public:
+	static bool RunIngest(const TArray<FString>& Args, UWorld* World);
+	static bool RunParse(const TArray<FString>& Args, UWorld* World);
+	static bool RunDispatch(const TArray<FString>& Args, UWorld* World);
+	static bool RunMaintenance(const TArray<FString>& Args, UWorld* World);
+	static bool RunZoneSync(const TArray<FString>& Args, UWorld* World);
+	static bool RunCommands(const TArray<FString>& Args, UWorld* World);
+	static bool RunCommandEncode(const TArray<FString>& Args, UWorld* World);
+	static bool RunLedEffects(const TArray<FString>& Args, UWorld* World);
+	static bool RunAll(const TArray<FString>& Args, UWorld* World);
+
+	/** Game world of a -game session or PIE, nullptr in a plain editor */
+	static UWorld* FindGameWorld();
+
+private:
+	static UAefDeepSyncSubsystem* BeginBench(UWorld* World, const TCHAR* Name);
+	static void EndBench(UAefDeepSyncSubsystem* Subsystem);
+
+	struct FResult
+	{
+		double NsPerOp = 0.0;
+
+		/** Heap kept after the run per op, negative without LLM */
+		double HeapBytesPerOp = -1.0;
+	};
+
+	/** Result of the measured run */
+	template <typename FuncType>
+	static FResult Measure(const TCHAR* Name, int64 Ops, const FString& Extra, FuncType&& Func);
+
+	/** Log a JSON result line and append it to Benchmarks.jsonl */
+	static void ReportLine(const FString& Line);
+
+	static FString MakeWearableMessage(int32 WearableId, int32 HeartRate, int32 Timestamp);
+	static AActor* SpawnBenchActor(UWorld* World, const FVector& Location);
+	static AAefPharusDeepSyncZoneActor* SpawnBenchZone(UWorld* World, const FVector& Location, int32 WearableId);
+
+	/** Write queued lanes and the send buffer until the socket took everything, false on a send error or stall */
+	static bool DrainCommands(UAefDeepSyncSubsystem* Subsystem);
+
+	/** Remove the benchmark wearables' entries from a per-wearable map */
+	template <typename MapType>
+	static void RemoveBenchWearables(MapType& Map);
+
+	/** Subsystem state a benchmark changes, restored afterwards (logging is switched off while measuring) */
+	struct FSavedState
+	{
+		FAefDeepSyncConfig Config;
+		FAefServerClock ServerClock;
+		FAefLatencyHistogram LatencyHistogram;
+		FAefLatencyHistogram ColorProbeHistogram;
+		FAefLatencyHistogram PreviousColorProbeHistogram;
+		int64 ColorProbesUnconfirmed = 0;
+		FAefLatencyHistogram CommandWaits[UAefDeepSyncSubsystem::NumCommandLanes];
+	};
+
+	static FSavedState Saved;
+
+	/** Actors spawned by the running benchmark */
+	static TArray<TWeakObjectPtr<AActor>> SpawnedActors;
+
+	/** Benchmark wearables use ids far above real devices */
+	static constexpr int32 BenchWearableIdBase = 100000;
+};
+
+FAefDeepSyncBenchmarks::FSavedState FAefDeepSyncBenchmarks::Saved;
+TArray<TWeakObjectPtr<AActor>> FAefDeepSyncBenchmarks::SpawnedActors;
+
+UWorld* FAefDeepSyncBenchmarks::FindGameWorld()
+{
+	if (!GEngine) return nullptr;
+
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		if ((Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) && Context.OwningGameInstance)
+		{
+			return Context.World();
+		}
+	}
+	return nullptr;
+}
+
+UAefDeepSyncSubsystem* FAefDeepSyncBenchmarks::BeginBench(UWorld* World, const TCHAR* Name)
+{
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	UAefDeepSyncSubsystem* Subsystem = GameInstance ? GameInstance->GetSubsystem<UAefDeepSyncSubsystem>() : nullptr;
+	if (!Subsystem)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.%s: needs a game instance (run in a game, e.g. -game -nullrhi)"), Name);
+		return nullptr;
+	}
+
+	// Benchmark data must not mix with real wearables and links
+	if (Subsystem->bWantsToRun || Subsystem->SyncedLinks.Num() > 0 || Subsystem->LinkTombstones.Num() > 0)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.%s: stop DeepSync and disconnect all links first"), Name);
+		return nullptr;
+	}
+
+	Saved.Config = Subsystem->Config;
+	Saved.ServerClock = Subsystem->ServerClock;
+	Saved.LatencyHistogram = Subsystem->LatencyHistogram;
+	Saved.ColorProbeHistogram = Subsystem->ColorProbeHistogram;
+	Saved.PreviousColorProbeHistogram = Subsystem->PreviousColorProbeHistogram;
+	Saved.ColorProbesUnconfirmed = Subsystem->ColorProbesUnconfirmed;
+	for (int32 LaneIndex = 0; LaneIndex < UAefDeepSyncSubsystem::NumCommandLanes; ++LaneIndex)
+	{
+		Saved.CommandWaits[LaneIndex] = Subsystem->CommandLanes[LaneIndex].WaitHistogram;
+	}
+
+	FAefDeepSyncConfig& Config = Subsystem->Config;
+	Config.bLogWearableConnected = false;
+	Config.bLogWearableLost = false;
+	Config.bLogWearableUpdated = false;
+	Config.bLogHeartRateChanges = false;
+	Config.bLogColorCommands = false;
+	Config.bLogIdCommands = false;
+	Config.bLogConnectionStatus = false;
+	Config.bLogSyncEvents = false;
+	Config.bLogNetworkErrors = false;
+	Config.AllowedWearableIds.Reset();
+	Config.LinkGraceWindow = 0.0f;
+	Config.TrackHandoffWindow = 0.0f;
+	Config.CaptureFile.Reset();
+	return Subsystem;
+}
+
+void FAefDeepSyncBenchmarks::EndBench(UAefDeepSyncSubsystem* Subsystem)
+{
+	// Zones first, their EndPlay still looks at wearables and links
+	for (const TWeakObjectPtr<AActor>& Actor : SpawnedActors)
+	{
+		if (AAefPharusDeepSyncZoneActor* Zone = Cast<AAefPharusDeepSyncZoneActor>(Actor.Get()))
+		{
+			Zone->Destroy();
+		}
+	}
+	for (const TWeakObjectPtr<AActor>& Actor : SpawnedActors)
+	{
+		if (Actor.IsValid())
+		{
+			Actor->Destroy();
+		}
+	}
+	SpawnedActors.Reset();
+
+	// Benchmark state is dropped silently, nobody should see those wearables leave
+	Subsystem->SyncedLinks.Reset();
+	Subsystem->LinkTombstones.Reset();
+	Subsystem->PendingHandoffs.Reset();
+	Subsystem->ActiveWearables.Reset();
+	Subsystem->ReceiveBuffer.Reset();
+	Subsystem->ClearCommandLanes(false);
+	RemoveBenchWearables(Subsystem->WearableLatencyHistograms);
+	RemoveBenchWearables(Subsystem->ColorProbes);
+	RemoveBenchWearables(Subsystem->ColorTargets);
+	RemoveBenchWearables(Subsystem->LedEffects);
+
+	// Statistics read as if the benchmark never ran
+	Subsystem->ServerClock = Saved.ServerClock;
+	Subsystem->LatencyHistogram = Saved.LatencyHistogram;
+	Subsystem->ColorProbeHistogram = Saved.ColorProbeHistogram;
+	Subsystem->PreviousColorProbeHistogram = Saved.PreviousColorProbeHistogram;
+	Subsystem->ColorProbesUnconfirmed = Saved.ColorProbesUnconfirmed;
+	for (int32 LaneIndex = 0; LaneIndex < UAefDeepSyncSubsystem::NumCommandLanes; ++LaneIndex)
+	{
+		Subsystem->CommandLanes[LaneIndex].WaitHistogram = Saved.CommandWaits[LaneIndex];
+	}
+	Subsystem->Config = Saved.Config;
+}
+
+template <typename MapType>
+void FAefDeepSyncBenchmarks::RemoveBenchWearables(MapType& Map)
+{
+	for (auto It = Map.CreateIterator(); It; ++It)
+	{
+		if (It.Key() >= BenchWearableIdBase)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool FAefDeepSyncBenchmarks::DrainCommands(UAefDeepSyncSubsystem* Subsystem)
+{
+	auto HasQueued = [Subsystem]()
+	{
+		const auto& Lanes = Subsystem->CommandLanes;
+		return Subsystem->SendBuffer.Num() > 0 ||
+			(Subsystem->Config.bCommandLanes && Lanes[0].Num() + Lanes[1].Num() + Lanes[2].Num() > 0);
+	};
+
+	const double Deadline = FPlatformTime::Seconds() + 10.0;
+	while (HasQueued())
+	{
+		if (Subsystem->bSendFailed || FPlatformTime::Seconds() > Deadline)
+		{
+			return false;
+		}
+		if (Subsystem->SendBuffer.Num() > 0)
+		{
+			Subsystem->FlushSendBuffer();
+		}
+		if (Subsystem->Config.bCommandLanes)
+		{
+			Subsystem->FlushCommandLanes();
+		}
+		if (Subsystem->SendBuffer.Num() > 0)
+		{
+			// Server thread has to read first
+			FPlatformProcess::YieldThread();
+		}
+	}
+	return !Subsystem->bSendFailed;
+}
+
+template <typename FuncType>
+FAefDeepSyncBenchmarks::FResult FAefDeepSyncBenchmarks::Measure(const TCHAR* Name, int64 Ops, const FString& Extra, FuncType&& Func)
+{
+	// Warm-up: first-time growth of maps and buffers is not steady-state cost
+	Func();
+
+	const int64 HeapBefore = GetBenchHeapBytes();
+	const double Start = FPlatformTime::Seconds();
+	{
+		LLM_SCOPE_BYTAG(AefDeepSyncBench);
+		Func();
+	}
+	const double Seconds = FPlatformTime::Seconds() - Start;
+	const int64 HeapAfter = GetBenchHeapBytes();
+
+	FResult Result;
+	Result.NsPerOp = Seconds * 1.0e9 / Ops;
+	FString HeapField;
+	if (HeapBefore >= 0 && HeapAfter >= 0)
+	{
+		Result.HeapBytesPerOp = static_cast<double>(HeapAfter - HeapBefore) / Ops;
+		HeapField = FString::Printf(TEXT(",\"heap_bytes_per_op\":%.2f"), Result.HeapBytesPerOp);
+	}
+
+	ReportLine(FString::Printf(TEXT("{\"bench\":\"%s\",\"ops\":%lld,\"ns_per_op\":%.1f%s%s}"),
+		Name, Ops, Result.NsPerOp, *HeapField, *Extra));
+	return Result;
+}
+
+void FAefDeepSyncBenchmarks::ReportLine(const FString& Line)
+{
+	UE_LOG(LogAefDeepSync, Display, TEXT("BENCH %s"), *Line);
+
+	const FString ResultsPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AefDeepSync"), TEXT("Benchmarks.jsonl"));
+	FFileHelper::SaveStringToFile(Line + LINE_TERMINATOR, *ResultsPath,
+		FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append);
+}
+
+FString FAefDeepSyncBenchmarks::MakeWearableMessage(int32 WearableId, int32 HeartRate, int32 Timestamp)
+{
+	// Same layout as the deepsyncwearablev2-server
+	return FString::Printf(TEXT("{\"Id\":%d,\"HeartRate\":%d,\"Timestamp\":%d,\"Color\":{\"R\":0,\"G\":255,\"B\":0}}"),
+		WearableId, HeartRate, Timestamp);
+}
+
+AActor* FAefDeepSyncBenchmarks::SpawnBenchActor(UWorld* World, const FVector& Location)
+{
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(Location), Params);
+	SpawnedActors.Add(Actor);
+	return Actor;
+}
+
+AAefPharusDeepSyncZoneActor* FAefDeepSyncBenchmarks::SpawnBenchZone(UWorld* World, const FVector& Location, int32 WearableId)
+{
+	// Far below the level, long sync so nothing completes while measuring
+	AAefPharusDeepSyncZoneActor* Zone = World->SpawnActorDeferred<AAefPharusDeepSyncZoneActor>(
+		AAefPharusDeepSyncZoneActor::StaticClass(), FTransform(Location), nullptr, nullptr,
+		ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	Zone->WearableId = WearableId;
+	Zone->SyncDuration = 60.0f;
+	Zone->FinishSpawning(FTransform(Location));
+	SpawnedActors.Add(Zone);
+	return Zone;
+}
+
+//--------------------------------------------------------------------------------
+// Receive Path
+//--------------------------------------------------------------------------------
+
+/**
+ * Framing + parsing + UpdateWearable for a captured-like byte stream, fed in
+ * 4096 byte reads like the socket path. ns_per_op is per message.
+ */
+bool FAefDeepSyncBenchmarks::RunIngest(const TArray<FString>& Args, UWorld* World)
+{
+	UAefDeepSyncSubsystem* Subsystem = BeginBench(World, TEXT("Ingest"));
+	if (!Subsystem) return false;
+
+	const int32 NumWearables = GetBenchArg(Args, 0, 100);
+	const int32 NumMessages = GetBenchArg(Args, 1, 100000);
+
+	TArray<uint8> Stream;
+	for (int32 i = 0; i < NumMessages; ++i)
+	{
+		FTCHARToUTF8 Converter(*(MakeWearableMessage(BenchWearableIdBase + i % NumWearables, 60 + i % 40, i) + TEXT("X")));
+		Stream.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+	}
+
+	Measure(TEXT("Ingest"), NumMessages, FString::Printf(TEXT(",\"wearables\":%d,\"bytes_per_op\":%.1f"),
+		NumWearables, static_cast<double>(Stream.Num()) / NumMessages), [Subsystem, &Stream]()
+	{
+		for (int32 Offset = 0; Offset < Stream.Num(); Offset += 4096)
+		{
+			Subsystem->ConsumeReceivedBytes(Stream.GetData() + Offset, FMath::Min(4096, Stream.Num() - Offset), FPlatformTime::Seconds() * 1000.0);
+		}
+	});
+
+	const int32 NumReceived = Subsystem->ActiveWearables.Num();
+	EndBench(Subsystem);
+
+	const int32 NumExpected = FMath::Min(NumWearables, NumMessages);
+	if (NumReceived != NumExpected)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.Ingest: FAILED - %d of %d wearables received"), NumReceived, NumExpected);
+		return false;
+	}
+	return true;
+}
+
+/** JSON parsing of single messages. ns_per_op is per message. */
+bool FAefDeepSyncBenchmarks::RunParse(const TArray<FString>& Args, UWorld* World)
+{
+	UAefDeepSyncSubsystem* Subsystem = BeginBench(World, TEXT("Parse"));
+	if (!Subsystem) return false;
+
+	const int32 NumMessages = GetBenchArg(Args, 0, 100000);
+
+	TArray<FString> Messages;
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		Messages.Add(MakeWearableMessage(BenchWearableIdBase + i, 60 + i % 40, i));
+	}
+
+	int32 Failures = 0;
+	Measure(TEXT("Parse"), NumMessages, FString(), [Subsystem, &Messages, &Failures, NumMessages]()
+	{
+		FAefDeepSyncWearableData Data;
+		for (int32 i = 0; i < NumMessages; ++i)
+		{
+			Failures += Subsystem->ParseWearableMessage(Messages[i % Messages.Num()], Data) ? 0 : 1;
+		}
+	});
+
+	if (Failures > 0)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.Parse: FAILED - %d messages not parsed"), Failures);
+	}
+	EndBench(Subsystem);
+	return Failures == 0;
+}
+
+/**
+ * UpdateWearable with OnWearableUpdated broadcast, forwarded by an
+ * AAefDeepSyncManager like in a typical level. ns_per_op is per message.
+ */
+bool FAefDeepSyncBenchmarks::RunDispatch(const TArray<FString>& Args, UWorld* World)
+{
+	UAefDeepSyncSubsystem* Subsystem = BeginBench(World, TEXT("Dispatch"));
+	if (!Subsystem) return false;
+
+	const int32 NumWearables = GetBenchArg(Args, 0, 100);
+	const int32 NumMessages = GetBenchArg(Args, 1, 100000);
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnedActors.Add(World->SpawnActor<AAefDeepSyncManager>(AAefDeepSyncManager::StaticClass(), FTransform::Identity, Params));
+
+	TArray<FAefDeepSyncWearableData> Updates;
+	Updates.SetNum(NumWearables);
+	for (int32 i = 0; i < NumWearables; ++i)
+	{
+		Updates[i].WearableId = BenchWearableIdBase + i;
+		Updates[i].HeartRate = 60 + i % 40;
+	}
+
+	Measure(TEXT("Dispatch"), NumMessages, FString::Printf(TEXT(",\"wearables\":%d,\"listeners\":%d"),
+		NumWearables, Subsystem->OnWearableUpdated.GetAllObjects().Num()), [Subsystem, &Updates, NumMessages]()
+	{
+		for (int32 i = 0; i < NumMessages; ++i)
+		{
+			FAefDeepSyncWearableData& Update = Updates[i % Updates.Num()];
+			Update.Timestamp = i;
+			Subsystem->UpdateWearable(Update);
+		}
+	});
+
+	// Every wearable must hold its last update
+	int32 Errors = 0;
+	for (int32 i = 0; i < FMath::Min(NumWearables, NumMessages); ++i)
+	{
+		const FAefDeepSyncWearableData* Wearable = Subsystem->ActiveWearables.Find(BenchWearableIdBase + i);
+		const int32 LastTimestamp = i + (NumMessages - 1 - i) / NumWearables * NumWearables;
+		Errors += (Wearable && Wearable->Timestamp == LastTimestamp) ? 0 : 1;
+	}
+	EndBench(Subsystem);
+
+	if (Errors > 0)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.Dispatch: FAILED - %d wearables missing or not up to date"), Errors);
+	}
+	return Errors == 0;
+}
+
+//--------------------------------------------------------------------------------
+// Per-Tick Maintenance
+//--------------------------------------------------------------------------------
+
+/**
+ * Wearable timeouts, link checks, tombstones and handoffs as run every
+ * connected tick (nothing expires). ns_per_op is per tick.
+ */
+bool FAefDeepSyncBenchmarks::RunMaintenance(const TArray<FString>& Args, UWorld* World)
+{
+	UAefDeepSyncSubsystem* Subsystem = BeginBench(World, TEXT("Maintenance"));
+	if (!Subsystem) return false;
+
+	const int32 NumWearables = GetBenchArg(Args, 0, 500);
+	const int32 NumLinks = FMath::Min(GetBenchArg(Args, 1, 200), NumWearables);
+	const int32 NumTicks = 1000;
+
+	for (int32 i = 0; i < NumWearables; ++i)
+	{
+		FAefDeepSyncWearableData Data;
+		Data.WearableId = BenchWearableIdBase + i;
+		Subsystem->UpdateWearable(Data);
+	}
+
+	AAefPharusDeepSyncZoneActor* Zone = SpawnBenchZone(World, FVector(0.0, 0.0, -100000.0), BenchWearableIdBase - 1);
+	for (int32 i = 0; i < NumLinks; ++i)
+	{
+		FAefSyncedLink& Link = Subsystem->SyncedLinks.AddDefaulted_GetRef();
+		Link.LinkId = Subsystem->NextLinkId++;
+		Link.WearableId = BenchWearableIdBase + i;
+		Link.PharusTrackID = BenchWearableIdBase + i;
+		Link.PharusActor = SpawnBenchActor(World, FVector(i * 100.0, 0.0, -100000.0));
+		Link.Zone = Zone;
+	}
+
+	Measure(TEXT("Maintenance"), NumTicks, FString::Printf(TEXT(",\"wearables\":%d,\"links\":%d"),
+		NumWearables, NumLinks), [Subsystem, NumTicks]()
+	{
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			Subsystem->CheckWearableTimeouts(0.0f);
+			Subsystem->UpdateTrackHandoffs(0.0f);
+			Subsystem->CheckForBrokenLinks();
+			Subsystem->UpdateLinkTombstones(0.0f);
+		}
+	});
+
+	if (Subsystem->SyncedLinks.Num() != NumLinks)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.Maintenance: FAILED - %d of %d links broke"), NumLinks - Subsystem->SyncedLinks.Num(), NumLinks);
+	}
+	const bool bPassed = Subsystem->SyncedLinks.Num() == NumLinks;
+	EndBench(Subsystem);
+	return bPassed;
+}
+
+/**
+ * Batched zone sync update with every zone syncing one track
+ * (presence, wearable check, progress broadcast). ns_per_op is per tick.
+ */
+bool FAefDeepSyncBenchmarks::RunZoneSync(const TArray<FString>& Args, UWorld* World)
+{
+	UAefDeepSyncSubsystem* Subsystem = BeginBench(World, TEXT("ZoneSync"));
+	if (!Subsystem) return false;
+
+	const int32 NumZones = GetBenchArg(Args, 0, 50);
+	const int32 NumTicks = 1000;
+
+	int32 NumSyncing = 0;
+	for (int32 i = 0; i < NumZones; ++i)
+	{
+		const int32 WearableId = BenchWearableIdBase + i;
+		FAefDeepSyncWearableData Data;
+		Data.WearableId = WearableId;
+		Subsystem->UpdateWearable(Data);
+
+		const FVector Location(i * 300.0, 0.0, -100000.0);
+		AAefPharusDeepSyncZoneActor* Zone = SpawnBenchZone(World, Location, WearableId);
+		AActor* Track = SpawnBenchActor(World, Location);
+
+		FAefZoneSyncCandidate& Candidate = Zone->SyncCandidates.AddDefaulted_GetRef();
+		Candidate.TrackID = WearableId;
+		Candidate.PharusActor = Track;
+		NumSyncing += Zone->StartSync(Candidate.TrackID, Track, 0.0f, true) ? 1 : 0;
+	}
+
+	// 1000 ticks x 0.1ms stay far below the 60s sync duration
+	Measure(TEXT("ZoneSync"), NumTicks, FString::Printf(TEXT(",\"zones\":%d,\"syncing\":%d"),
+		NumZones, NumSyncing), [Subsystem, NumTicks]()
+	{
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			Subsystem->TickZoneSyncSessions(0.0001f);
+		}
+	});
+
+	if (NumSyncing != NumZones)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.ZoneSync: FAILED - only %d of %d zones syncing"), NumSyncing, NumZones);
+	}
+	EndBench(Subsystem);
+	return NumSyncing == NumZones;
+}
+
+//--------------------------------------------------------------------------------
+// Commands
+//--------------------------------------------------------------------------------
+
+/**
+ * Color command encode + Send to a synthetic server on loopback
+ * (uses the configured ports). ns_per_op is per command.
+ */
+bool FAefDeepSyncBenchmarks::RunCommands(const TArray<FString>& Args, UWorld* World)
+{
+	UAefDeepSyncSubsystem* Subsystem = BeginBench(World, TEXT("Commands"));
+	if (!Subsystem) return false;
+
+	const int32 NumCommands = GetBenchArg(Args, 0, 2000);
+
+	FAefSyntheticServerSettings ServerSettings;
+	ServerSettings.ReceiverPort = Subsystem->Config.ReceiverPort;
+	ServerSettings.SenderPort = Subsystem->Config.SenderPort;
+	ServerSettings.NumWearables = 0;
+
+	FAefDeepSyncSyntheticServer Server;
+	Subsystem->Config.ServerIP = TEXT("127.0.0.1");
+	if (!Server.Start(ServerSettings) || !Subsystem->ConnectToServer())
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.Commands: FAILED - no loopback connection on ports %d/%d"),
+			ServerSettings.ReceiverPort, ServerSettings.SenderPort);
+		Subsystem->DisconnectFromServer();
+		EndBench(Subsystem);
+		return false;
+	}
+
+	const EAefDeepSyncConnectionStatus SavedStatus = Subsystem->ConnectionStatus;
+	Subsystem->SetConnectionStatus(EAefDeepSyncConnectionStatus::Connected);
+
+	// Queued lanes and the send buffer are written inside the timed run, it ends once the socket took every byte
+	int32 Failures = 0;
+	bool bDrained = true;
+	Measure(TEXT("Commands"), NumCommands, FString::Printf(TEXT(",\"lanes\":%s"), Subsystem->Config.bCommandLanes ? TEXT("true") : TEXT("false")),
+		[Subsystem, &Failures, &bDrained, NumCommands]()
+	{
+		for (int32 i = 0; i < NumCommands; ++i)
+		{
+			const FAefDeepSyncColor Color(static_cast<uint8>(i), 255, 0);
+			Failures += Subsystem->SendColorCommand(BenchWearableIdBase + i % 100, Color) ? 0 : 1;
+		}
+		bDrained &= DrainCommands(Subsystem);
+	});
+
+	// Warm-up and measured run, all of it has to arrive
+	const int64 NumExpected = 2 * static_cast<int64>(NumCommands);
+	const double Deadline = FPlatformTime::Seconds() + 5.0;
+	while (Server.GetCommandsReceived() < NumExpected && FPlatformTime::Seconds() < Deadline)
+	{
+		FPlatformProcess::Sleep(0.01f);
+	}
+	const int64 NumReceived = Server.GetCommandsReceived();
+
+	Subsystem->DisconnectFromServer();
+	Subsystem->SetConnectionStatus(SavedStatus);
+	Server.Shutdown();
+	EndBench(Subsystem);
+
+	if (Failures > 0 || !bDrained || NumReceived != NumExpected)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.Commands: FAILED - %d sends failed, %s, server received %lld of %lld"),
+			Failures, bDrained ? TEXT("drained") : TEXT("send buffer stuck"), NumReceived, NumExpected);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Color and ID command encoding without a socket: the old Printf + UTF-8
+ * conversion against FAefDeepSyncCommandEncoder. Both must produce the same
+ * bytes. ns_per_op is per command.
+ */
+bool FAefDeepSyncBenchmarks::RunCommandEncode(const TArray<FString>& Args, UWorld* World)
+{
+	const int32 NumCommands = GetBenchArg(Args, 0, 100000);
+
+	// Same bytes as the Printf path, for every digit count and the ID command
+	int32 Mismatches = 0;
+	FAefDeepSyncCommandEncoder Encoder;
+	const int32 CheckIds[] = { 0, 7, 15, 99, 12345, -1, MAX_int32, MIN_int32 };
+	for (int32 Id : CheckIds)
+	{
+		const FAefDeepSyncColor Color(static_cast<uint8>(Id), 0, 255);
+		Encoder.Reset();
+		Encoder.AppendColorCommand(Id, Color);
+		Encoder.AppendIdCommand(Id, Id / 3);
+		const FString Expected = FString::Printf(TEXT("{\"Id\":%d,\"Color\":{\"R\":%d,\"G\":%d,\"B\":%d}}X{\"type\":\"id\",\"Id\":%d,\"NewId\":%d}X"),
+			Id, Color.R, Color.G, Color.B, Id, Id / 3);
+		Mismatches += Encoder.ToString() == Expected ? 0 : 1;
+	}
+
+	int64 Bytes = 0;
+	const FResult Printf = Measure(TEXT("CommandEncodePrintf"), NumCommands, FString(), [NumCommands, &Bytes]()
+	{
+		Bytes = 0;
+		for (int32 i = 0; i < NumCommands; ++i)
+		{
+			const FString JsonCommand = FString::Printf(TEXT("{\"Id\":%d,\"Color\":{\"R\":%d,\"G\":%d,\"B\":%d}}X"),
+				BenchWearableIdBase + i % 100, i & 255, 255, 0);
+			FTCHARToUTF8 Converter(*JsonCommand);
+			Bytes += Converter.Length();
+		}
+	});
+
+	const SIZE_T EncoderSize = Encoder.GetAllocatedSize();
+	const FResult Encoded = Measure(TEXT("CommandEncode"), NumCommands, FString(), [NumCommands, &Encoder, &Bytes]()
+	{
+		Bytes = 0;
+		for (int32 i = 0; i < NumCommands; ++i)
+		{
+			Encoder.Reset();
+			Encoder.AppendColorCommand(BenchWearableIdBase + i % 100, FAefDeepSyncColor(static_cast<uint8>(i), 255, 0));
+			Bytes += Encoder.Num();
+		}
+	});
+
+	UE_LOG(LogAefDeepSync, Display, TEXT("Bench.CommandEncode: encoder %.1f M commands/s, Printf + UTF-8 %.1f M commands/s (%.1f bytes per command)"),
+		1.0e3 / Encoded.NsPerOp, 1.0e3 / Printf.NsPerOp, static_cast<double>(Bytes) / NumCommands);
+
+	if (Mismatches > 0)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.CommandEncode: FAILED - %d commands differ from the Printf encoding"), Mismatches);
+	}
+
+	// The encoder's point: its buffer never grows (or reallocates) for single commands
+	const bool bBufferKept = Encoder.GetAllocatedSize() == EncoderSize;
+	if (!bBufferKept || Encoded.HeapBytesPerOp > 0.0)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.CommandEncode: FAILED - encoder buffer grew from %llu to %llu bytes"),
+			static_cast<uint64>(EncoderSize), static_cast<uint64>(Encoder.GetAllocatedSize()));
+	}
+	return Mismatches == 0 && bBufferKept && Encoded.HeapBytesPerOp <= 0.0;
+}
+
+//--------------------------------------------------------------------------------
+// LED Effects
+//--------------------------------------------------------------------------------
+
+/**
+ * Pulse effects on every wearable for a few seconds of real time, sent to a
+ * synthetic server on loopback. Streamed effects must stay within
+ * effectCommandRate per wearable, uploaded effects (serverEffects) must send
+ * nothing but the upload. ns_per_op is per streamed effect step.
+ */
+bool FAefDeepSyncBenchmarks::RunLedEffects(const TArray<FString>& Args, UWorld* World)
+{
+	UAefDeepSyncSubsystem* Subsystem = BeginBench(World, TEXT("LedEffects"));
+	if (!Subsystem) return false;
+
+	const int32 NumWearables = GetBenchArg(Args, 0, 50);
+	const double Seconds = GetBenchArg(Args, 1, 2);
+
+	FAefSyntheticServerSettings ServerSettings;
+	ServerSettings.ReceiverPort = Subsystem->Config.ReceiverPort;
+	ServerSettings.SenderPort = Subsystem->Config.SenderPort;
+	ServerSettings.NumWearables = 0;
+
+	FAefDeepSyncSyntheticServer Server;
+	Subsystem->Config.ServerIP = TEXT("127.0.0.1");
+	if (!Server.Start(ServerSettings) || !Subsystem->ConnectToServer())
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.LedEffects: FAILED - no loopback connection on ports %d/%d"),
+			ServerSettings.ReceiverPort, ServerSettings.SenderPort);
+		Subsystem->DisconnectFromServer();
+		EndBench(Subsystem);
+		return false;
+	}
+
+	const EAefDeepSyncConnectionStatus SavedStatus = Subsystem->ConnectionStatus;
+	Subsystem->SetConnectionStatus(EAefDeepSyncConnectionStatus::Connected);
+
+	// Effects are only streamed to wearables that are online
+	for (int32 i = 0; i < NumWearables; ++i)
+	{
+		FAefDeepSyncWearableData Data;
+		Data.WearableId = BenchWearableIdBase + i;
+		Subsystem->UpdateWearable(Data);
+	}
+
+	// A fast pulse changes the 8-bit color on every step, the worst case for the command rate
+	FAefLedEffect Effect;
+	Effect.Type = EAefLedEffectType::Pulse;
+	Effect.Duration = 0.5f;
+
+	// Pass 0 streams the colors, pass 1 uploads the effects
+	int64 NumCommands[2] = {};
+	double Elapsed[2] = {};
+	int32 NumSteps = 0;
+	double StepSeconds = 0.0;
+	bool bDrained = true;
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		Subsystem->Config.bServerEffects = Pass == 1;
+		const int64 CommandsBefore = Server.GetCommandsReceived();
+		for (int32 i = 0; i < NumWearables; ++i)
+		{
+			Subsystem->PlayLedEffect(BenchWearableIdBase + i, Effect);
+		}
+
+		// Ticked at ~60 Hz in real time like the game thread, the effect clock is real time too
+		const double Start = FPlatformTime::Seconds();
+		double LastTick = Start;
+		while (FPlatformTime::Seconds() - Start < Seconds)
+		{
+			const double Now = FPlatformTime::Seconds();
+			Subsystem->TickLedEffects(static_cast<float>(Now - LastTick));
+			bDrained &= DrainCommands(Subsystem);
+			LastTick = Now;
+			if (Pass == 0)
+			{
+				StepSeconds += FPlatformTime::Seconds() - Now;
+				++NumSteps;
+			}
+			FPlatformProcess::Sleep(1.0f / 60.0f);
+		}
+		Elapsed[Pass] = FPlatformTime::Seconds() - Start;
+
+		// Let the server read what the socket took, then stop (uploads a "none" effect in pass 1)
+		FPlatformProcess::Sleep(0.2f);
+		NumCommands[Pass] = Server.GetCommandsReceived() - CommandsBefore;
+		Subsystem->StopAllLedEffects();
+		bDrained &= DrainCommands(Subsystem);
+		FPlatformProcess::Sleep(0.2f);
+	}
+
+	Subsystem->DisconnectFromServer();
+	Subsystem->SetConnectionStatus(SavedStatus);
+	Server.Shutdown();
+
+	// Steps are timed by the effect clock, one extra step per wearable for the timer phase
+	const double CommandRate = FMath::Max(Subsystem->Config.EffectCommandRate, 1.0f);
+	const double MaxCommands = CommandRate * NumWearables * Elapsed[0] + NumWearables;
+	EndBench(Subsystem);
+
+	ReportLine(FString::Printf(TEXT("{\"bench\":\"LedEffects\",\"ops\":%d,\"ns_per_op\":%.1f,\"wearables\":%d,\"commands_per_s\":%.1f,\"limit_per_s\":%.1f,\"upload_commands\":%lld}"),
+		NumSteps, NumSteps > 0 ? StepSeconds * 1.0e9 / NumSteps : 0.0, NumWearables, NumCommands[0] / Elapsed[0], CommandRate * NumWearables, NumCommands[1]));
+
+	bool bPassed = bDrained;
+	if (!bDrained)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.LedEffects: FAILED - commands not written (send error or stuck send buffer)"));
+	}
+	if (NumCommands[0] == 0 || NumCommands[0] > MaxCommands)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.LedEffects: FAILED - %lld streamed commands in %.2fs, expected 1 to %.0f"), NumCommands[0], Elapsed[0], MaxCommands);
+		bPassed = false;
+	}
+	if (NumCommands[1] != NumWearables)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Bench.LedEffects: FAILED - %lld commands with serverEffects, expected only the %d uploads"), NumCommands[1], NumWearables);
+		bPassed = false;
+	}
+	return bPassed;
+}
+
+bool FAefDeepSyncBenchmarks::RunAll(const TArray<FString>& Args, UWorld* World)
+{
+	// Every benchmark runs even if an earlier one failed
+	const TArray<FString> Defaults;
+	bool bPassed = RunIngest(Defaults, World);
+	bPassed = RunParse(Defaults, World) && bPassed;
+	bPassed = RunDispatch(Defaults, World) && bPassed;
+	bPassed = RunMaintenance(Defaults, World) && bPassed;
+	bPassed = RunZoneSync(Defaults, World) && bPassed;
+	bPassed = RunCommands(Defaults, World) && bPassed;
+	bPassed = RunCommandEncode(Defaults, World) && bPassed;
+	bPassed = RunLedEffects(Defaults, World) && bPassed;
+	return bPassed;
+}
+
+static FAutoConsoleCommand GAefBenchIngestCommand(
+	TEXT("AefDeepSync.Bench.Ingest"),
+	TEXT("Receive path (framing, parsing, UpdateWearable) per message. Args: [NumWearables=100] [NumMessages=100000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) { FAefDeepSyncBenchmarks::RunIngest(Args, World); }));
+
+static FAutoConsoleCommand GAefBenchParseCommand(
+	TEXT("AefDeepSync.Bench.Parse"),
+	TEXT("JSON message parsing per message. Args: [NumMessages=100000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) { FAefDeepSyncBenchmarks::RunParse(Args, World); }));
+
+static FAutoConsoleCommand GAefBenchDispatchCommand(
+	TEXT("AefDeepSync.Bench.Dispatch"),
+	TEXT("UpdateWearable and event broadcast per message. Args: [NumWearables=100] [NumMessages=100000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) { FAefDeepSyncBenchmarks::RunDispatch(Args, World); }));
+
+static FAutoConsoleCommand GAefBenchMaintenanceCommand(
+	TEXT("AefDeepSync.Bench.Maintenance"),
+	TEXT("Wearable timeouts and link checks per tick. Args: [NumWearables=500] [NumLinks=200]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) { FAefDeepSyncBenchmarks::RunMaintenance(Args, World); }));
+
+static FAutoConsoleCommand GAefBenchZoneSyncCommand(
+	TEXT("AefDeepSync.Bench.ZoneSync"),
+	TEXT("Batched zone sync update per tick with every zone syncing. Args: [NumZones=50]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) { FAefDeepSyncBenchmarks::RunZoneSync(Args, World); }));
+
+static FAutoConsoleCommand GAefBenchCommandsCommand(
+	TEXT("AefDeepSync.Bench.Commands"),
+	TEXT("Color command encode and send over loopback per command. Args: [NumCommands=2000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) { FAefDeepSyncBenchmarks::RunCommands(Args, World); }));
+
+static FAutoConsoleCommand GAefBenchCommandEncodeCommand(
+	TEXT("AefDeepSync.Bench.CommandEncode"),
+	TEXT("Color command encoding, Printf + UTF-8 vs. command encoder, per command. Args: [NumCommands=100000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) { FAefDeepSyncBenchmarks::RunCommandEncode(Args, World); }));
+
+static FAutoConsoleCommand GAefBenchLedEffectsCommand(
+	TEXT("AefDeepSync.Bench.LedEffects"),
+	TEXT("LED effects streamed and uploaded to a loopback synthetic server, checks the command rate. Args: [NumWearables=50] [Seconds=2]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) { FAefDeepSyncBenchmarks::RunLedEffects(Args, World); }));
+
+static FAutoConsoleCommand GAefBenchAllCommand(
+	TEXT("AefDeepSync.Bench.All"),
+	TEXT("Run all pipeline benchmarks with default arguments"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) { FAefDeepSyncBenchmarks::RunAll(Args, World); }));
+
+//--------------------------------------------------------------------------------
+// Automation Tests
+//--------------------------------------------------------------------------------
+
+// Default arguments, a test fails when its benchmark reports a wrong result
+static constexpr EAutomationTestFlags AefBenchTestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter;
+
+/** Pipeline benchmarks need the game instance's subsystem */
+static bool RunPipelineBenchTest(FAutomationTestBase& Test, bool (*Run)(const TArray<FString>&, UWorld*))
+{
+	UWorld* World = FAefDeepSyncBenchmarks::FindGameWorld();
+	if (!World)
+	{
+		Test.AddError(TEXT("No game world, run with -game -nullrhi or in PIE"));
+		return false;
+	}
+	return Run(TArray<FString>(), World);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAefDeepSyncBenchZoneHashTest, "AefDeepSync.Bench.ZoneHash", AefBenchTestFlags)
+bool FAefDeepSyncBenchZoneHashTest::RunTest(const FString& Parameters)
+{
+	return RunZoneHashBenchmark(TArray<FString>());
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAefDeepSyncBenchZoneAssignmentTest, "AefDeepSync.Bench.ZoneAssignment", AefBenchTestFlags)
+bool FAefDeepSyncBenchZoneAssignmentTest::RunTest(const FString& Parameters)
+{
+	return RunZoneAssignmentBenchmark(TArray<FString>());
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAefDeepSyncBenchIngestTest, "AefDeepSync.Bench.Ingest", AefBenchTestFlags)
+bool FAefDeepSyncBenchIngestTest::RunTest(const FString& Parameters)
+{
+	return RunPipelineBenchTest(*this, &FAefDeepSyncBenchmarks::RunIngest);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAefDeepSyncBenchParseTest, "AefDeepSync.Bench.Parse", AefBenchTestFlags)
+bool FAefDeepSyncBenchParseTest::RunTest(const FString& Parameters)
+{
+	return RunPipelineBenchTest(*this, &FAefDeepSyncBenchmarks::RunParse);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAefDeepSyncBenchDispatchTest, "AefDeepSync.Bench.Dispatch", AefBenchTestFlags)
+bool FAefDeepSyncBenchDispatchTest::RunTest(const FString& Parameters)
+{
+	return RunPipelineBenchTest(*this, &FAefDeepSyncBenchmarks::RunDispatch);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAefDeepSyncBenchMaintenanceTest, "AefDeepSync.Bench.Maintenance", AefBenchTestFlags)
+bool FAefDeepSyncBenchMaintenanceTest::RunTest(const FString& Parameters)
+{
+	return RunPipelineBenchTest(*this, &FAefDeepSyncBenchmarks::RunMaintenance);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAefDeepSyncBenchZoneSyncTest, "AefDeepSync.Bench.ZoneSync", AefBenchTestFlags)
+bool FAefDeepSyncBenchZoneSyncTest::RunTest(const FString& Parameters)
+{
+	return RunPipelineBenchTest(*this, &FAefDeepSyncBenchmarks::RunZoneSync);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAefDeepSyncBenchCommandsTest, "AefDeepSync.Bench.Commands", AefBenchTestFlags)
+bool FAefDeepSyncBenchCommandsTest::RunTest(const FString& Parameters)
+{
+	return RunPipelineBenchTest(*this, &FAefDeepSyncBenchmarks::RunCommands);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAefDeepSyncBenchCommandEncodeTest, "AefDeepSync.Bench.CommandEncode", AefBenchTestFlags)
+bool FAefDeepSyncBenchCommandEncodeTest::RunTest(const FString& Parameters)
+{
+	return FAefDeepSyncBenchmarks::RunCommandEncode(TArray<FString>(), nullptr);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAefDeepSyncBenchLedEffectsTest, "AefDeepSync.Bench.LedEffects", AefBenchTestFlags)
+bool FAefDeepSyncBenchLedEffectsTest::RunTest(const FString& Parameters)
+{
+	return RunPipelineBenchTest(*this, &FAefDeepSyncBenchmarks::RunLedEffects);
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,178 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Stream Capture Implementation
+========================================================================*/
+
+#include "AefDeepSyncCapture.h"
+#include "AefDeepSyncTypes.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/Paths.h"
+
+//--------------------------------------------------------------------------------
+// Capture Writer
+//--------------------------------------------------------------------------------
+
+FAefDeepSyncCaptureWriter::~FAefDeepSyncCaptureWriter()
+{
+	Close();
+}
+
+bool FAefDeepSyncCaptureWriter::Open(const FString& InPath)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(InPath));
+	FileHandle.Reset(PlatformFile.OpenWrite(*InPath, false, false));
+	if (!FileHandle)
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("Capture: cannot open %s"), *InPath);
+		return false;
+	}
+
+	const uint32 Header[2] = { FileMagic, FileVersion };
+	FileHandle->Write(reinterpret_cast<const uint8*>(Header), sizeof(Header));
+
+	Buffer.Reset(FlushThreshold + ChunkHeaderSize + 4096);
+	StartCycles = FPlatformTime::Cycles64();
+	CapturedBytes = 0;
+	return true;
+}
+
+void FAefDeepSyncCaptureWriter::Close()
+{
+	if (FileHandle)
+	{
+		Flush();
+		FileHandle.Reset();
+	}
+}
+
+void FAefDeepSyncCaptureWriter::Write(const uint8* Data, int32 Num)
+{
+	if (!FileHandle || Num <= 0) return;
+
+	const uint64 TimeMicros = static_cast<uint64>(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1.0e6);
+	const uint32 Size = static_cast<uint32>(Num);
+
+	const int32 Offset = Buffer.AddUninitialized(ChunkHeaderSize + Num);
+	uint8* Dest = Buffer.GetData() + Offset;
+	FMemory::Memcpy(Dest, &TimeMicros, sizeof(TimeMicros));
+	FMemory::Memcpy(Dest + sizeof(TimeMicros), &Size, sizeof(Size));
+	FMemory::Memcpy(Dest + ChunkHeaderSize, Data, Num);
+	CapturedBytes += Num;
+
+	if (Buffer.Num() >= FlushThreshold)
+	{
+		Flush();
+	}
+}
+
+void FAefDeepSyncCaptureWriter::Flush()
+{
+	if (Buffer.Num() > 0)
+	{
+		FileHandle->Write(Buffer.GetData(), Buffer.Num());
+		FileHandle->Flush();
+		Buffer.Reset();
+	}
+}
+
+//--------------------------------------------------------------------------------
+// Capture Reader
+//--------------------------------------------------------------------------------
+
+FAefDeepSyncCaptureReader::~FAefDeepSyncCaptureReader()
+{
+	Close();
+}
+
+bool FAefDeepSyncCaptureReader::Open(const FString& InPath)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	MappedFile.Reset(PlatformFile.OpenMapped(*InPath));
+	if (!MappedFile)
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("Capture: cannot map %s"), *InPath);
+		return false;
+	}
+
+	FileSize = MappedFile->GetFileSize();
+	const uint8* Header = MapRange(0, 2 * sizeof(uint32));
+	if (!Header ||
+		reinterpret_cast<const uint32*>(Header)[0] != FAefDeepSyncCaptureWriter::FileMagic ||
+		reinterpret_cast<const uint32*>(Header)[1] != FAefDeepSyncCaptureWriter::FileVersion)
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("Capture: %s is not a DeepSync capture"), *InPath);
+		Close();
+		return false;
+	}
+
+	ReadOffset = 2 * sizeof(uint32);
+	return true;
+}
+
+void FAefDeepSyncCaptureReader::Close()
+{
+	Window.Reset();
+	MappedFile.Reset();
+	WindowOffset = 0;
+	WindowNum = 0;
+	FileSize = 0;
+	ReadOffset = 0;
+}
+
+bool FAefDeepSyncCaptureReader::Next(FAefCaptureChunk& OutChunk)
+{
+	if (!MappedFile) return false;
+
+	const uint8* Header = MapRange(ReadOffset, FAefDeepSyncCaptureWriter::ChunkHeaderSize);
+	if (!Header) return false;
+
+	uint64 TimeMicros = 0;
+	uint32 Size = 0;
+	FMemory::Memcpy(&TimeMicros, Header, sizeof(TimeMicros));
+	FMemory::Memcpy(&Size, Header + sizeof(TimeMicros), sizeof(Size));
+
+	const int64 DataOffset = ReadOffset + FAefDeepSyncCaptureWriter::ChunkHeaderSize;
+	const uint8* Data = MapRange(DataOffset, Size);
+	if (!Data) return false;
+
+	OutChunk.TimeMicros = TimeMicros;
+	OutChunk.Data = Data;
+	OutChunk.Num = static_cast<int32>(Size);
+	ReadOffset = DataOffset + Size;
+	return true;
+}
+
+float FAefDeepSyncCaptureReader::GetProgress() const
+{
+	return FileSize > 0 ? static_cast<float>(static_cast<double>(ReadOffset) / FileSize) : 0.0f;
+}
+
+const uint8* FAefDeepSyncCaptureReader::MapRange(int64 Offset, int64 Num)
+{
+	if (Offset + Num > FileSize)
+	{
+		return nullptr;
+	}
+
+	if (!Window || Offset < WindowOffset || Offset + Num > WindowOffset + WindowNum)
+	{
+		// Release the old window first, only one window is resident at a time
+		Window.Reset();
+		WindowOffset = Offset;
+		WindowNum = FMath::Min(FMath::Max(WindowSize, Num), FileSize - Offset);
+		Window.Reset(MappedFile->MapRegion(WindowOffset, WindowNum));
+		if (!Window)
+		{
+			return nullptr;
+		}
+	}
+
+	return Window->GetMappedPtr() + (Offset - WindowOffset);
+}
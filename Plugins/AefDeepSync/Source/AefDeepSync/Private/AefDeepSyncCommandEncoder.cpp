@@ -0,0 +1,100 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Command Encoder Implementation
+========================================================================*/
+
+#include "AefDeepSyncCommandEncoder.h"
+
+void FAefDeepSyncCommandEncoder::AppendColorCommand(int32 WearableId, const FAefDeepSyncColor& Color)
+{
+	if (bTypeTags)
+	{
+		AppendLiteral("{\"type\":\"color\",\"Id\":");
+	}
+	else
+	{
+		AppendLiteral("{\"Id\":");
+	}
+	AppendInt(WearableId);
+	AppendColor(Color);
+}
+
+void FAefDeepSyncCommandEncoder::AppendGroupColorCommand(TConstArrayView<int32> WearableIds, const FAefDeepSyncColor& Color)
+{
+	if (bTypeTags)
+	{
+		AppendLiteral("{\"type\":\"color\",\"Ids\":[");
+	}
+	else
+	{
+		AppendLiteral("{\"Ids\":[");
+	}
+	for (int32 i = 0; i < WearableIds.Num(); ++i)
+	{
+		if (i > 0)
+		{
+			Buffer.Add(',');
+		}
+		AppendInt(WearableIds[i]);
+	}
+	Buffer.Add(']');
+	AppendColor(Color);
+}
+
+void FAefDeepSyncCommandEncoder::AppendIdCommand(int32 WearableId, int32 NewId)
+{
+	// "type" field for polymorphic deserialization on the server
+	AppendLiteral("{\"type\":\"id\",\"Id\":");
+	AppendInt(WearableId);
+	AppendLiteral(",\"NewId\":");
+	AppendInt(NewId);
+	AppendLiteral("}X");
+}
+
+void FAefDeepSyncCommandEncoder::AppendPingCommand(int32 Seq)
+{
+	AppendLiteral("{\"type\":\"ping\",\"Seq\":");
+	AppendInt(Seq);
+	AppendLiteral("}X");
+}
+
+FString FAefDeepSyncCommandEncoder::ToString() const
+{
+	return FString::ConstructFromPtrSize(reinterpret_cast<const ANSICHAR*>(Buffer.GetData()), Buffer.Num());
+}
+
+void FAefDeepSyncCommandEncoder::AppendInt(int32 Value)
+{
+	// Digits are produced backwards, the magnitude as unsigned so INT32_MIN works
+	ANSICHAR Digits[11];
+	int32 Length = 0;
+	uint32 Magnitude = Value < 0 ? 0u - static_cast<uint32>(Value) : static_cast<uint32>(Value);
+	do
+	{
+		Digits[Length++] = static_cast<ANSICHAR>('0' + Magnitude % 10);
+		Magnitude /= 10;
+	}
+	while (Magnitude > 0);
+
+	if (Value < 0)
+	{
+		Buffer.Add('-');
+	}
+	const int32 Start = Buffer.AddUninitialized(Length);
+	for (int32 i = 0; i < Length; ++i)
+	{
+		Buffer[Start + i] = static_cast<uint8>(Digits[Length - 1 - i]);
+	}
+}
+
+void FAefDeepSyncCommandEncoder::AppendColor(const FAefDeepSyncColor& Color)
+{
+	AppendLiteral(",\"Color\":{\"R\":");
+	AppendInt(Color.R);
+	AppendLiteral(",\"G\":");
+	AppendInt(Color.G);
+	AppendLiteral(",\"B\":");
+	AppendInt(Color.B);
+	AppendLiteral("}}X");
+}
@@ -8,6 +8,7 @@
 
 #include "AefDeepSyncComponent.h"
 #include "AefDeepSyncSubsystem.h"
+#include "AefDeepSyncStats.h"
 #include "Engine/GameInstance.h"
 
 UAefDeepSyncComponent::UAefDeepSyncComponent()
@@ -40,6 +41,7 @@ void UAefDeepSyncComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 void UAefDeepSyncComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_Component);
 
 	// Update data from subsystem each tick for responsive editor display
 	if (bWasBound)
@@ -207,6 +209,8 @@ void UAefDeepSyncComponent::HandleSubsystemWearableLost(const FAefDeepSyncWearab
 
 void UAefDeepSyncComponent::HandleSubsystemWearableUpdated(int32 Id, const FAefDeepSyncWearableData& Data)
 {
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_Component);
+
 	// Filter for our WearableId
 	if (Id != WearableId)
 	{
@@ -0,0 +1,74 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - LED Effects Implementation
+========================================================================*/
+
+#include "AefDeepSyncEffects.h"
+
+const ANSICHAR* FAefLedEffect::GetTypeName() const
+{
+	switch (Type)
+	{
+		case EAefLedEffectType::Solid: return "solid";
+		case EAefLedEffectType::Fade: return "fade";
+		case EAefLedEffectType::Pulse: return "pulse";
+		case EAefLedEffectType::HeartRatePulse: return "heartrate";
+	}
+	return "solid";
+}
+
+void FAefLedEffectState::Start(const FAefLedEffect& InEffect, double Now)
+{
+	Effect = InEffect;
+	StartTime = Now;
+	LastStepTime = Now;
+	BeatPhase = 0.0f;
+	bHasSent = false;
+	bUploaded = false;
+	bFinished = false;
+}
+
+FAefDeepSyncColor FAefLedEffectState::Step(double Now, int32 HeartRate, bool& bOutFinished)
+{
+	const float Time = static_cast<float>(Now - StartTime);
+	const float DeltaTime = static_cast<float>(Now - LastStepTime);
+	const float Duration = FMath::Max(Effect.Duration, 0.01f);
+	LastStepTime = Now;
+
+	float Alpha = 1.0f;
+	bOutFinished = false;
+	switch (Effect.Type)
+	{
+		case EAefLedEffectType::Solid:
+		{
+			bOutFinished = true;
+			break;
+		}
+		case EAefLedEffectType::Fade:
+		{
+			Alpha = FMath::Clamp(Time / Duration, 0.0f, 1.0f);
+			bOutFinished = Time >= Duration;
+			break;
+		}
+		case EAefLedEffectType::Pulse:
+		{
+			const float Cycles = Time / Duration;
+			bOutFinished = Effect.Repeat > 0 && Cycles >= Effect.Repeat;
+			Alpha = bOutFinished ? 0.0f : 0.5f - 0.5f * FMath::Cos(UE_TWO_PI * Cycles);
+			break;
+		}
+		case EAefLedEffectType::HeartRatePulse:
+		{
+			const float BeatsPerSecond = HeartRate > 0 ? HeartRate / 60.0f : 1.0f / Duration;
+			BeatPhase += DeltaTime * BeatsPerSecond;
+			bOutFinished = Effect.Repeat > 0 && BeatPhase >= Effect.Repeat;
+
+			// Sharp attack on the beat, exponential decay until the next one
+			Alpha = bOutFinished ? 0.0f : FMath::Exp(-5.0f * FMath::Frac(BeatPhase));
+			break;
+		}
+	}
+
+	return FAefDeepSyncColor::FromLinearColor(FMath::Lerp(Effect.FromColor, Effect.ToColor, Alpha));
+}
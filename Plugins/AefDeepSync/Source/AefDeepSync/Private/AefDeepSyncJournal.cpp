@@ -0,0 +1,299 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Warm-Start Journal Implementation
+========================================================================*/
+
+#include "AefDeepSyncJournal.h"
+#include "AefDeepSyncTypes.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Crc.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+static FArchive& operator<<(FArchive& Ar, FAefJournalLink& Link)
+{
+	Ar << Link.LinkId;
+	Ar << Link.WearableId;
+	Ar << Link.PharusTrackID;
+	Ar << Link.ZoneWearableId;
+	Ar << Link.LastPharusPosition;
+	Ar << Link.ZoneColor;
+	Ar << Link.SyncTimeTicks;
+	return Ar;
+}
+
+FAefDeepSyncJournal::~FAefDeepSyncJournal()
+{
+	Close();
+}
+
+bool FAefDeepSyncJournal::Open(const FString& InPath)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(InPath));
+	FileHandle.Reset(PlatformFile.OpenWrite(*InPath, false, true));
+	if (!FileHandle)
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("Journal: cannot open %s"), *InPath);
+		return false;
+	}
+
+	Path = InPath;
+	bStopping = false;
+	BytesSinceCompaction = 0;
+
+	uint32 Magic = FileMagic;
+	FileHandle->Write(reinterpret_cast<const uint8*>(&Magic), sizeof(Magic));
+
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("AefDeepSyncJournal"), 0, TPri_BelowNormal);
+	if (!Thread)
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("Journal: cannot start the writer thread"));
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void FAefDeepSyncJournal::Close()
+{
+	if (Thread)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+	if (WakeEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+	}
+	FileHandle.Reset();
+}
+
+//--------------------------------------------------------------------------------
+// Records
+//--------------------------------------------------------------------------------
+
+void FAefDeepSyncJournal::WriteLink(const FAefJournalLink& Link)
+{
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+	FAefJournalLink Copy = Link;
+	Writer << Copy;
+	Enqueue(ERecordType::Link, MoveTemp(Payload));
+}
+
+void FAefDeepSyncJournal::WriteLinkBroken(int32 LinkId)
+{
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+	Writer << LinkId;
+	Enqueue(ERecordType::LinkBroken, MoveTemp(Payload));
+}
+
+void FAefDeepSyncJournal::WriteSnapshot(int32 NextUniqueId, int32 NextLinkId, const TMap<int32, int32>& WearableUniqueIds)
+{
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+	Writer << NextUniqueId;
+	Writer << NextLinkId;
+	int32 Count = WearableUniqueIds.Num();
+	Writer << Count;
+	for (const TPair<int32, int32>& Pair : WearableUniqueIds)
+	{
+		int32 WearableId = Pair.Key;
+		int32 UniqueId = Pair.Value;
+		Writer << WearableId;
+		Writer << UniqueId;
+	}
+	Enqueue(ERecordType::Snapshot, MoveTemp(Payload));
+}
+
+void FAefDeepSyncJournal::BeginCompaction()
+{
+	if (!IsOpen()) return;
+
+	FPendingWrite Write;
+	Write.bTruncate = true;
+	Queue.Enqueue(MoveTemp(Write));
+	BytesSinceCompaction = 0;
+	WakeEvent->Trigger();
+}
+
+void FAefDeepSyncJournal::Enqueue(ERecordType Type, TArray<uint8>&& Payload)
+{
+	if (!IsOpen()) return;
+
+	// Snapshots of very large floors would not fit the 16 bit size field
+	if (!ensure(Payload.Num() <= MAX_uint16)) return;
+
+	FPendingWrite Write;
+	Write.Data.Reserve(RecordHeaderSize + Payload.Num());
+	FMemoryWriter Writer(Write.Data);
+	uint8 TypeByte = static_cast<uint8>(Type);
+	uint8 Version = RecordVersion;
+	uint16 Size = static_cast<uint16>(Payload.Num());
+	uint32 Crc = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+	Writer << TypeByte << Version << Size << Crc;
+	Write.Data.Append(Payload);
+
+	BytesSinceCompaction += Write.Data.Num();
+	Queue.Enqueue(MoveTemp(Write));
+	WakeEvent->Trigger();
+}
+
+//--------------------------------------------------------------------------------
+// Writer Thread
+//--------------------------------------------------------------------------------
+
+uint32 FAefDeepSyncJournal::Run()
+{
+	while (!bStopping)
+	{
+		WakeEvent->Wait();
+		DrainQueue();
+	}
+	DrainQueue();
+	return 0;
+}
+
+void FAefDeepSyncJournal::Stop()
+{
+	bStopping = true;
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FAefDeepSyncJournal::DrainQueue()
+{
+	bool bWrote = false;
+	FPendingWrite Write;
+	while (Queue.Dequeue(Write))
+	{
+		if (Write.bTruncate)
+		{
+			uint32 Magic = FileMagic;
+			FileHandle->Seek(0);
+			FileHandle->Truncate(0);
+			FileHandle->Write(reinterpret_cast<const uint8*>(&Magic), sizeof(Magic));
+		}
+		if (Write.Data.Num() > 0)
+		{
+			FileHandle->Write(Write.Data.GetData(), Write.Data.Num());
+		}
+		bWrote = true;
+	}
+
+	if (bWrote)
+	{
+		FileHandle->Flush();
+	}
+}
+
+//--------------------------------------------------------------------------------
+// Replay
+//--------------------------------------------------------------------------------
+
+bool FAefDeepSyncJournal::Replay(const FString& InPath, FAefJournalState& OutState)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*InPath))
+	{
+		return false;
+	}
+
+	// Map the file instead of copying it, fall back to a plain read where mapping is unsupported
+	TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*InPath));
+	if (MappedFile && MappedFile->GetFileSize() > 0)
+	{
+		TUniquePtr<IMappedFileRegion> Region(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+		if (Region)
+		{
+			return ReadRecords(Region->GetMappedPtr(), Region->GetMappedSize(), OutState);
+		}
+	}
+
+	TArray<uint8> FileData;
+	return FFileHelper::LoadFileToArray(FileData, *InPath) && ReadRecords(FileData.GetData(), FileData.Num(), OutState);
+}
+
+bool FAefDeepSyncJournal::ReadRecords(const uint8* Data, int64 Size, FAefJournalState& OutState)
+{
+	if (Size < static_cast<int64>(sizeof(uint32)) || *reinterpret_cast<const uint32*>(Data) != FileMagic)
+	{
+		return false;
+	}
+
+	int64 Offset = sizeof(uint32);
+	while (Offset + RecordHeaderSize <= Size)
+	{
+		FMemoryReaderView HeaderReader(TArrayView<const uint8>(Data + Offset, RecordHeaderSize));
+		uint8 TypeByte = 0;
+		uint8 Version = 0;
+		uint16 PayloadSize = 0;
+		uint32 Crc = 0;
+		HeaderReader << TypeByte << Version << PayloadSize << Crc;
+
+		// Torn tail from a crash mid-write, or a record of a newer version
+		const uint8* Payload = Data + Offset + RecordHeaderSize;
+		if (Offset + RecordHeaderSize + PayloadSize > Size || Version != RecordVersion ||
+			FCrc::MemCrc32(Payload, PayloadSize) != Crc)
+		{
+			break;
+		}
+		Offset += RecordHeaderSize + PayloadSize;
+
+		FMemoryReaderView Reader(TArrayView<const uint8>(Payload, PayloadSize));
+		switch (static_cast<ERecordType>(TypeByte))
+		{
+			case ERecordType::Link:
+			{
+				FAefJournalLink Link;
+				Reader << Link;
+				OutState.Links.Add(Link.LinkId, Link);
+				OutState.NextLinkId = FMath::Max(OutState.NextLinkId, Link.LinkId + 1);
+				break;
+			}
+			case ERecordType::LinkBroken:
+			{
+				int32 LinkId = -1;
+				Reader << LinkId;
+				OutState.Links.Remove(LinkId);
+				break;
+			}
+			case ERecordType::Snapshot:
+			{
+				int32 NextUniqueId = 0;
+				int32 NextLinkId = 0;
+				int32 Count = 0;
+				Reader << NextUniqueId << NextLinkId << Count;
+				OutState.NextUniqueId = FMath::Max(OutState.NextUniqueId, NextUniqueId);
+				OutState.NextLinkId = FMath::Max(OutState.NextLinkId, NextLinkId);
+				OutState.WearableUniqueIds.Reset();
+				for (int32 i = 0; i < Count && !Reader.IsError(); ++i)
+				{
+					int32 WearableId = -1;
+					int32 UniqueId = -1;
+					Reader << WearableId << UniqueId;
+					OutState.WearableUniqueIds.Add(WearableId, UniqueId);
+				}
+				break;
+			}
+			default:
+				break;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,220 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Latency Implementation
+========================================================================*/
+
+#include "AefDeepSyncLatency.h"
+
+//--------------------------------------------------------------------------------
+// Latency Histogram
+//--------------------------------------------------------------------------------
+
+int32 FAefLatencyHistogram::GetBucket(double LatencyMs)
+{
+	if (LatencyMs < LinearRangeMs)
+	{
+		return FMath::Max(0, FMath::FloorToInt32(LatencyMs));
+	}
+	if (LatencyMs < MaxRangeMs)
+	{
+		return LinearRangeMs + FMath::FloorToInt32((LatencyMs - LinearRangeMs) / CoarseBucketMs);
+	}
+	return NumBuckets - 1;
+}
+
+void FAefLatencyHistogram::Add(double LatencyMs)
+{
+	++Buckets[GetBucket(LatencyMs)];
+	++Count;
+	Sum += LatencyMs;
+	Max = FMath::Max(Max, LatencyMs);
+}
+
+void FAefLatencyHistogram::Append(const FAefLatencyHistogram& Other)
+{
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		Buckets[Bucket] += Other.Buckets[Bucket];
+	}
+	Count += Other.Count;
+	Sum += Other.Sum;
+	Max = FMath::Max(Max, Other.Max);
+}
+
+void FAefLatencyHistogram::Reset()
+{
+	FMemory::Memzero(Buckets);
+	Count = 0;
+	Sum = 0.0;
+	Max = 0.0;
+}
+
+double FAefLatencyHistogram::GetPercentile(double Percentile) const
+{
+	if (Count == 0) return 0.0;
+
+	const int64 Target = FMath::Max<int64>(1, FMath::CeilToInt64(FMath::Clamp(Percentile, 0.0, 1.0) * Count));
+	int64 Cumulative = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		Cumulative += Buckets[Bucket];
+		if (Cumulative >= Target)
+		{
+			// Upper edge of the bucket, never above the largest sample
+			double UpperMs = Max;
+			if (Bucket < LinearRangeMs)
+			{
+				UpperMs = Bucket + 1.0;
+			}
+			else if (Bucket < NumBuckets - 1)
+			{
+				UpperMs = LinearRangeMs + (Bucket - LinearRangeMs + 1.0) * CoarseBucketMs;
+			}
+			return FMath::Min(UpperMs, Max);
+		}
+	}
+	return Max;
+}
+
+//--------------------------------------------------------------------------------
+// Server Clock Estimator
+//--------------------------------------------------------------------------------
+
+void FAefServerClock::Configure(double InWindowSeconds, int32 InNumWindows)
+{
+	WindowMs = FMath::Max(0.1, InWindowSeconds) * 1000.0;
+	NumWindows = FMath::Max(1, InNumWindows);
+}
+
+bool FAefServerClock::Unwrap(int32 RawTimestamp, int64& OutServerTime)
+{
+	if (!bHasRaw)
+	{
+		bHasRaw = true;
+		LastRaw = RawTimestamp;
+		LastServerTime = RawTimestamp;
+		OutServerTime = LastServerTime;
+		return true;
+	}
+
+	// Modular difference, a wrap of the int32 counter is a small positive step
+	const int32 Delta = static_cast<int32>(static_cast<uint32>(RawTimestamp) - static_cast<uint32>(LastRaw));
+	if (Delta >= 0)
+	{
+		LastRaw = RawTimestamp;
+		LastServerTime += Delta;
+		OutServerTime = LastServerTime;
+		return true;
+	}
+
+	if (Delta > -RestartThresholdMs)
+	{
+		// Reordered message (wearables are stamped independently)
+		OutServerTime = LastServerTime + Delta;
+		return true;
+	}
+
+	// Server restarted, continue the timeline where it was
+	LastRaw = RawTimestamp;
+	OutServerTime = LastServerTime;
+	ResetEstimate();
+	return false;
+}
+
+double FAefServerClock::AddSample(int64 ServerTime, double LocalMs)
+{
+	const double OffsetMs = LocalMs - static_cast<double>(ServerTime);
+
+	if (!bCurrentValid)
+	{
+		CurrentStartMs = LocalMs;
+		Current = { LocalMs, OffsetMs };
+		bCurrentValid = true;
+	}
+	else if (LocalMs - CurrentStartMs >= WindowMs)
+	{
+		CloseWindow();
+		CurrentStartMs = LocalMs;
+		Current = { LocalMs, OffsetMs };
+	}
+	else if (OffsetMs < Current.MinOffsetMs)
+	{
+		Current = { LocalMs, OffsetMs };
+	}
+
+	if (!bHasEstimate)
+	{
+		return 0.0;
+	}
+	return FMath::Max(0.0, OffsetMs - GetOffsetMs(LocalMs));
+}
+
+double FAefServerClock::GetOffsetMs(double LocalMs) const
+{
+	return Intercept + Slope * (LocalMs - OriginMs);
+}
+
+void FAefServerClock::CloseWindow()
+{
+	Windows.Add(Current);
+	if (Windows.Num() > NumWindows)
+	{
+		Windows.RemoveAt(0, Windows.Num() - NumWindows);
+	}
+	Fit();
+}
+
+void FAefServerClock::Fit()
+{
+	// Least squares through the window minima
+	double MeanX = 0.0;
+	double MeanY = 0.0;
+	for (const FWindow& Window : Windows)
+	{
+		MeanX += Window.LocalMs;
+		MeanY += Window.MinOffsetMs;
+	}
+	MeanX /= Windows.Num();
+	MeanY /= Windows.Num();
+
+	double Covariance = 0.0;
+	double Variance = 0.0;
+	for (const FWindow& Window : Windows)
+	{
+		Covariance += (Window.LocalMs - MeanX) * (Window.MinOffsetMs - MeanY);
+		Variance += FMath::Square(Window.LocalMs - MeanX);
+	}
+
+	// Real clocks drift by a few ppm, anything beyond 1000 ppm is noise of a short history
+	OriginMs = MeanX;
+	Intercept = MeanY;
+	Slope = Variance > 0.0 ? FMath::Clamp(Covariance / Variance, -1.0e-3, 1.0e-3) : 0.0;
+
+	// Lower the line below every minimum, the fastest messages define zero latency
+	double Lowest = 0.0;
+	for (const FWindow& Window : Windows)
+	{
+		Lowest = FMath::Min(Lowest, Window.MinOffsetMs - GetOffsetMs(Window.LocalMs));
+	}
+	Intercept += Lowest;
+	bHasEstimate = true;
+}
+
+void FAefServerClock::Reset()
+{
+	bHasRaw = false;
+	LastRaw = 0;
+	LastServerTime = 0;
+	ResetEstimate();
+}
+
+void FAefServerClock::ResetEstimate()
+{
+	Windows.Reset();
+	bCurrentValid = false;
+	bHasEstimate = false;
+	OriginMs = 0.0;
+	Intercept = 0.0;
+	Slope = 0.0;
+}
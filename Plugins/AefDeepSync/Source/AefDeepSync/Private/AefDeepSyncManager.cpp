@@ -6,6 +6,7 @@
 
 #include "AefDeepSyncManager.h"
 #include "AefDeepSyncSubsystem.h"
+#include "AefDeepSyncStats.h"
 #include "AefPharusDeepSyncZoneActor.h"
 #include "Kismet/GameplayStatics.h"
 
@@ -121,6 +122,8 @@ void AAefDeepSyncManager::BindSubsystemEvents()
 	// Bind sync link events
 	Subsystem->OnLinkEstablished.AddDynamic(this, &AAefDeepSyncManager::HandleLinkEstablished);
 	Subsystem->OnLinkBroken.AddDynamic(this, &AAefDeepSyncManager::HandleLinkBroken);
+	Subsystem->OnLinkRestored.AddDynamic(this, &AAefDeepSyncManager::HandleLinkRestored);
+	Subsystem->OnLinkTrackReassigned.AddDynamic(this, &AAefDeepSyncManager::HandleLinkTrackReassigned);
 	Subsystem->OnZoneRegistered.AddDynamic(this, &AAefDeepSyncManager::HandleZoneRegistered);
 	Subsystem->OnZoneUnregistered.AddDynamic(this, &AAefDeepSyncManager::HandleZoneUnregistered);
 
@@ -145,6 +148,8 @@ void AAefDeepSyncManager::UnbindSubsystemEvents()
 	// Unbind sync link events
 	Subsystem->OnLinkEstablished.RemoveDynamic(this, &AAefDeepSyncManager::HandleLinkEstablished);
 	Subsystem->OnLinkBroken.RemoveDynamic(this, &AAefDeepSyncManager::HandleLinkBroken);
+	Subsystem->OnLinkRestored.RemoveDynamic(this, &AAefDeepSyncManager::HandleLinkRestored);
+	Subsystem->OnLinkTrackReassigned.RemoveDynamic(this, &AAefDeepSyncManager::HandleLinkTrackReassigned);
 	Subsystem->OnZoneRegistered.RemoveDynamic(this, &AAefDeepSyncManager::HandleZoneRegistered);
 	Subsystem->OnZoneUnregistered.RemoveDynamic(this, &AAefDeepSyncManager::HandleZoneUnregistered);
 
@@ -167,6 +172,7 @@ void AAefDeepSyncManager::HandleWearableLost(const FAefDeepSyncWearableData& Dat
 
 void AAefDeepSyncManager::HandleWearableUpdated(int32 WearableId, const FAefDeepSyncWearableData& Data)
 {
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_ManagerForward);
 	OnWearableUpdated.Broadcast(WearableId, Data);
 }
 
@@ -185,6 +191,16 @@ void AAefDeepSyncManager::HandleLinkBroken(const FAefSyncedLink& Link, const FSt
 	OnLinkBroken.Broadcast(Link, Reason);
 }
 
+void AAefDeepSyncManager::HandleLinkRestored(const FAefSyncedLink& Link)
+{
+	OnLinkRestored.Broadcast(Link);
+}
+
+void AAefDeepSyncManager::HandleLinkTrackReassigned(const FAefSyncedLink& Link, int32 OldPharusTrackID)
+{
+	OnLinkTrackReassigned.Broadcast(Link, OldPharusTrackID);
+}
+
 void AAefDeepSyncManager::HandleZoneRegistered(AAefPharusDeepSyncZoneActor* Zone)
 {
 	OnZoneRegistered.Broadcast(Zone);
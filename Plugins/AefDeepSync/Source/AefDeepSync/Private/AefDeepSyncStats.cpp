@@ -0,0 +1,57 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Stats Implementation
+========================================================================*/
+
+#include "AefDeepSyncStats.h"
+
+DEFINE_STAT(STAT_AefDeepSync_Tick);
+DEFINE_STAT(STAT_AefDeepSync_Receive);
+DEFINE_STAT(STAT_AefDeepSync_Parse);
+DEFINE_STAT(STAT_AefDeepSync_Dispatch);
+DEFINE_STAT(STAT_AefDeepSync_WearableTimeouts);
+DEFINE_STAT(STAT_AefDeepSync_LinkMaintenance);
+DEFINE_STAT(STAT_AefDeepSync_ZoneSync);
+DEFINE_STAT(STAT_AefDeepSync_ZoneDetection);
+DEFINE_STAT(STAT_AefDeepSync_ZoneAssignment);
+DEFINE_STAT(STAT_AefDeepSync_ZoneOverlap);
+DEFINE_STAT(STAT_AefDeepSync_Journal);
+DEFINE_STAT(STAT_AefDeepSync_SendCommand);
+DEFINE_STAT(STAT_AefDeepSync_LedEffects);
+DEFINE_STAT(STAT_AefDeepSync_Component);
+DEFINE_STAT(STAT_AefDeepSync_ManagerForward);
+
+DEFINE_STAT(STAT_AefDeepSync_Messages);
+DEFINE_STAT(STAT_AefDeepSync_BytesReceived);
+DEFINE_STAT(STAT_AefDeepSync_CommandsSent);
+DEFINE_STAT(STAT_AefDeepSync_ColorReconcileCommands);
+DEFINE_STAT(STAT_AefDeepSync_LedEffectCommands);
+
+DEFINE_STAT(STAT_AefDeepSync_ParseFailures);
+DEFINE_STAT(STAT_AefDeepSync_ReceiveBacklog);
+DEFINE_STAT(STAT_AefDeepSync_SendBacklog);
+DEFINE_STAT(STAT_AefDeepSync_ActiveWearables);
+DEFINE_STAT(STAT_AefDeepSync_Links);
+DEFINE_STAT(STAT_AefDeepSync_PendingRelinks);
+DEFINE_STAT(STAT_AefDeepSync_ZonesSyncing);
+DEFINE_STAT(STAT_AefDeepSync_ColorTargetsPending);
+DEFINE_STAT(STAT_AefDeepSync_LedEffectsPlaying);
+DEFINE_STAT(STAT_AefDeepSync_OldestWearableData);
+DEFINE_STAT(STAT_AefDeepSync_LatencyP50);
+DEFINE_STAT(STAT_AefDeepSync_LatencyP95);
+DEFINE_STAT(STAT_AefDeepSync_LatencyP99);
+DEFINE_STAT(STAT_AefDeepSync_ClockDrift);
+DEFINE_STAT(STAT_AefDeepSync_ColorCommandP95);
+DEFINE_STAT(STAT_AefDeepSync_UnconfirmedColorCommands);
+DEFINE_STAT(STAT_AefDeepSync_PendingColorCommands);
+DEFINE_STAT(STAT_AefDeepSync_CommandQueueCritical);
+DEFINE_STAT(STAT_AefDeepSync_CommandQueueNormal);
+DEFINE_STAT(STAT_AefDeepSync_CommandQueueBackground);
+DEFINE_STAT(STAT_AefDeepSync_CommandWaitCritical);
+DEFINE_STAT(STAT_AefDeepSync_CommandWaitNormal);
+DEFINE_STAT(STAT_AefDeepSync_CommandWaitBackground);
+DEFINE_STAT(STAT_AefDeepSync_HeartbeatRtt);
+DEFINE_STAT(STAT_AefDeepSync_TimeSinceReceive);
+
+CSV_DEFINE_CATEGORY_MODULE(AEFDEEPSYNC_API, AefDeepSync, true);
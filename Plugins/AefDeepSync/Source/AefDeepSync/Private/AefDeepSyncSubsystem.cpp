@@ -5,7 +5,12 @@
 ========================================================================*/
 
 #include "AefDeepSyncSubsystem.h"
+#include "AefDeepSyncStats.h"
+#include "AefDeepSyncTrace.h"
 #include "AefPharusDeepSyncZoneActor.h"
+#include "AefPharusTrackAccessor.h"
+#include "Components/SphereComponent.h"
+#include "EngineUtils.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
 #include "Networking.h"
@@ -15,6 +20,7 @@
 #include "Dom/JsonObject.h"
 #include "Misc/ConfigCacheIni.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
 
 DEFINE_LOG_CATEGORY(LogAefDeepSync);
 
@@ -27,6 +33,11 @@ void UAefDeepSyncSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	Super::Initialize(Collection);
 	LoadConfiguration();
 
+	if (Config.bJournalEnabled)
+	{
+		OpenJournal();
+	}
+
 	if (Config.bLogConnectionStatus)
 	{
 		UE_LOG(LogAefDeepSync, Log, TEXT("AefDeepSync initialized (AutoStart=%s)"),
@@ -42,6 +53,8 @@ void UAefDeepSyncSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 void UAefDeepSyncSubsystem::Deinitialize()
 {
 	StopDeepSync();
+	StopTrackingPharusActors();
+	Journal.Close();
 	if (Config.bLogConnectionStatus)
 	{
 		UE_LOG(LogAefDeepSync, Log, TEXT("AefDeepSync deinitialized"));
@@ -55,6 +68,22 @@ void UAefDeepSyncSubsystem::Deinitialize()
 
 void UAefDeepSyncSubsystem::Tick(float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_Tick);
+	CSV_SCOPED_TIMING_STAT(AefDeepSync, Tick);
+	ON_SCOPE_EXIT { PublishFrameStats(); };
+
+	// Zone syncs are advanced here in one batch (zones don't tick themselves).
+	// Zone actors used to tick with the world, keep pausing consistent with that.
+	const UWorld* World = GetWorld();
+	if (!World || !World->IsPaused())
+	{
+		if (UsesSpatialZoneDetection() && RegisteredZones.Num() > 0)
+		{
+			UpdateZoneOccupancy();
+		}
+		TickZoneSyncSessions(DeltaTime);
+	}
+
 	if (!bWantsToRun) return;
 
 	// Handle reconnection
@@ -74,6 +103,7 @@ void UAefDeepSyncSubsystem::Tick(float DeltaTime)
 				SetConnectionStatus(EAefDeepSyncConnectionStatus::Connected);
 				ReconnectAttempts = 0;
 				CurrentReconnectDelay = Config.ReconnectDelay;
+				BeginWearableTimeoutHold();
 			}
 			else
 			{
@@ -100,15 +130,80 @@ void UAefDeepSyncSubsystem::Tick(float DeltaTime)
 	// Process data when connected
 	if (ConnectionStatus == EAefDeepSyncConnectionStatus::Connected)
 	{
-		ProcessReceivedData();
-		CheckWearableTimeouts(DeltaTime);
+		if (bReplaying)
+		{
+			ProcessReplayData(DeltaTime);
+		}
+		else
+		{
+			ProcessReceivedData();
+			if (Config.bHeartbeat)
+			{
+				TickHeartbeat(DeltaTime);
+			}
+
+			// A receive error or the watchdog may have dropped the connection above
+			const bool bStillConnected = ConnectionStatus == EAefDeepSyncConnectionStatus::Connected;
+			if (bStillConnected && ColorTargets.Num() > 0)
+			{
+				ReconcileColorTargets(DeltaTime);
+			}
+			if (bStillConnected && LedEffects.Num() > 0)
+			{
+				TickLedEffects(DeltaTime);
+			}
+			if (bStillConnected && IdJobs.Num() > 0)
+			{
+				TickIdProvisioning();
+			}
+		}
+		if (bHoldWearableTimeouts)
+		{
+			WearableTimeoutHoldTimer -= DeltaTime;
+			if (Config.ReconnectGraceTimeout > 0.0f && WearableTimeoutHoldTimer <= 0.0f)
+			{
+				ResumeWearableTimeouts(TEXT("no data within grace timeout"));
+			}
+		}
+		else
+		{
+			CheckWearableTimeouts(DeltaTime);
+		}
+		UpdateTrackHandoffs(DeltaTime);
 		CheckForBrokenLinks();
+		UpdateLinkTombstones(DeltaTime);
+		UpdateJournal(DeltaTime);
+		if (ColorProbes.Num() > 0)
+		{
+			ExpireColorProbes();
+		}
+		if (ConnectionStatus == EAefDeepSyncConnectionStatus::Connected)
+		{
+			if (SendBuffer.Num() > 0)
+			{
+				FlushSendBuffer();
+			}
+			if (Config.bCommandLanes)
+			{
+				FlushCommandLanes();
+			}
+		}
+
+		// Deferred from SendCommandBytes, callers may still have been iterating queues
+		if (bSendFailed && ConnectionStatus == EAefDeepSyncConnectionStatus::Connected)
+		{
+			if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Warning, TEXT("Command connection lost"));
+			SetConnectionStatus(EAefDeepSyncConnectionStatus::Reconnecting);
+			DisconnectFromServer();
+			ReconnectTimer = Config.ReconnectDelay;
+		}
 	}
 }
 
 bool UAefDeepSyncSubsystem::IsTickable() const
 {
-	return bWantsToRun;
+	return bWantsToRun || ZoneSyncSessions.Num() > 0 ||
+		(UsesSpatialZoneDetection() && RegisteredZones.Num() > 0);
 }
 
 TStatId UAefDeepSyncSubsystem::GetStatId() const
@@ -116,6 +211,68 @@ TStatId UAefDeepSyncSubsystem::GetStatId() const
 	RETURN_QUICK_DECLARE_CYCLE_STAT(UAefDeepSyncSubsystem, STATGROUP_Tickables);
 }
 
+void UAefDeepSyncSubsystem::PublishFrameStats()
+{
+	SET_DWORD_STAT(STAT_AefDeepSync_ReceiveBacklog, ReceiveBuffer.Len());
+	SET_DWORD_STAT(STAT_AefDeepSync_SendBacklog, SendBuffer.Num());
+	SET_DWORD_STAT(STAT_AefDeepSync_ActiveWearables, ActiveWearables.Num());
+	SET_DWORD_STAT(STAT_AefDeepSync_Links, SyncedLinks.Num());
+	SET_DWORD_STAT(STAT_AefDeepSync_PendingRelinks, LinkTombstones.Num());
+	SET_DWORD_STAT(STAT_AefDeepSync_ZonesSyncing, GetSyncingZoneCount());
+	SET_DWORD_STAT(STAT_AefDeepSync_ColorTargetsPending, ColorTargets.Num() > 0 ? GetPendingTargetColorCount() : 0);
+	SET_DWORD_STAT(STAT_AefDeepSync_LedEffectsPlaying, LedEffects.Num());
+
+	if (Config.bCommandLanes)
+	{
+		SET_DWORD_STAT(STAT_AefDeepSync_CommandQueueCritical, CommandLanes[0].Num());
+		SET_DWORD_STAT(STAT_AefDeepSync_CommandQueueNormal, CommandLanes[1].Num());
+		SET_DWORD_STAT(STAT_AefDeepSync_CommandQueueBackground, CommandLanes[2].Num());
+		SET_FLOAT_STAT(STAT_AefDeepSync_CommandWaitCritical, CommandLanes[0].WaitHistogram.GetPercentile(0.95));
+		SET_FLOAT_STAT(STAT_AefDeepSync_CommandWaitNormal, CommandLanes[1].WaitHistogram.GetPercentile(0.95));
+		SET_FLOAT_STAT(STAT_AefDeepSync_CommandWaitBackground, CommandLanes[2].WaitHistogram.GetPercentile(0.95));
+	}
+
+	CSV_CUSTOM_STAT(AefDeepSync, Messages, FrameMessageCount, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AefDeepSync, BytesReceived, FrameBytesReceived, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AefDeepSync, ActiveWearables, ActiveWearables.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AefDeepSync, Links, SyncedLinks.Num(), ECsvCustomStatOp::Set);
+
+	if (Config.bMeasureLatency && LatencyHistogram.GetCount() > 0)
+	{
+		const float P95 = static_cast<float>(LatencyHistogram.GetPercentile(0.95));
+		SET_FLOAT_STAT(STAT_AefDeepSync_LatencyP50, LatencyHistogram.GetPercentile(0.50));
+		SET_FLOAT_STAT(STAT_AefDeepSync_LatencyP95, P95);
+		SET_FLOAT_STAT(STAT_AefDeepSync_LatencyP99, LatencyHistogram.GetPercentile(0.99));
+		SET_FLOAT_STAT(STAT_AefDeepSync_ClockDrift, ServerClock.GetDriftPpm());
+		CSV_CUSTOM_STAT(AefDeepSync, LatencyP95, P95, ECsvCustomStatOp::Set);
+	}
+
+	if (Config.bHeartbeat)
+	{
+		SET_FLOAT_STAT(STAT_AefDeepSync_HeartbeatRtt, FMath::Max(0.0f, HeartbeatRttMs));
+		SET_FLOAT_STAT(STAT_AefDeepSync_TimeSinceReceive, GetTimeSinceLastReceive());
+	}
+
+	if (Config.bProbeColorCommands)
+	{
+		// Rotate the color command histogram, the rolling view covers the last one to two windows
+		const double Now = FPlatformTime::Seconds();
+		if (Now - ColorProbeWindowStart >= Config.ColorProbeWindow)
+		{
+			PreviousColorProbeHistogram = ColorProbeHistogram;
+			ColorProbeHistogram.Reset();
+			ColorProbeWindowStart = Now;
+		}
+
+		SET_FLOAT_STAT(STAT_AefDeepSync_ColorCommandP95, GetColorCommandLatencyStats().P95Ms);
+		SET_DWORD_STAT(STAT_AefDeepSync_UnconfirmedColorCommands, ColorProbesUnconfirmed);
+		SET_DWORD_STAT(STAT_AefDeepSync_PendingColorCommands, GetPendingColorCommandCount());
+	}
+
+	FrameMessageCount = 0;
+	FrameBytesReceived = 0;
+}
+
 //--------------------------------------------------------------------------------
 // Connection Management
 //--------------------------------------------------------------------------------
@@ -128,6 +285,17 @@ void UAefDeepSyncSubsystem::StartDeepSync()
 		return;
 	}
 
+	if (!Config.ReplayFile.IsEmpty())
+	{
+		StartReplay(Config.ReplayFile, Config.ReplaySpeed);
+		return;
+	}
+
+	if (!Config.CaptureFile.IsEmpty() && !CaptureWriter.IsOpen())
+	{
+		StartCapture(Config.CaptureFile);
+	}
+
 	bWantsToRun = true;
 	SetConnectionStatus(EAefDeepSyncConnectionStatus::Connecting);
 
@@ -147,6 +315,7 @@ void UAefDeepSyncSubsystem::StartDeepSync()
 void UAefDeepSyncSubsystem::StopDeepSync()
 {
 	bWantsToRun = false;
+	bHoldWearableTimeouts = false;
 
 	// Fire OnWearableLost for all active wearables
 	for (const auto& Pair : ActiveWearables)
@@ -158,9 +327,17 @@ void UAefDeepSyncSubsystem::StopDeepSync()
 		OnWearableLost.Broadcast(Pair.Value);
 	}
 	ActiveWearables.Empty();
+	WearableLatencyHistograms.Empty();
 
 	DisconnectFromServer();
+	ClearCommandLanes(false);
+	StopCapture();
+	ReplayReader.Close();
+	bReplaying = false;
+	bHasPendingReplayChunk = false;
+	ServerClock.Reset();
 	SetConnectionStatus(EAefDeepSyncConnectionStatus::Disconnected);
+	TRACE_AEFDEEPSYNC(Reset());
 }
 
 bool UAefDeepSyncSubsystem::IsRunning() const
@@ -172,127 +349,102 @@ bool UAefDeepSyncSubsystem::IsRunning() const
 
 bool UAefDeepSyncSubsystem::ConnectToServer()
 {
-	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-	if (!SocketSubsystem)
-	{
-		if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Error, TEXT("Socket subsystem unavailable"));
-		return false;
-	}
-
-	// Create receiver socket address
-	TSharedRef<FInternetAddr> ReceiverAddr = SocketSubsystem->CreateInternetAddr();
-	bool bIsValid = false;
-	ReceiverAddr->SetIp(*Config.ServerIP, bIsValid);
-	if (!bIsValid)
+	// Duplex: data and commands share one connection, it is either up or down
+	if (Config.bDuplexConnection)
 	{
-		if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Error, TEXT("Invalid IP: %s"), *Config.ServerIP);
-		return false;
+		const int32 DuplexPort = Config.DuplexPort > 0 ? Config.DuplexPort : Config.ReceiverPort;
+		ReceiverSocket = OpenConnection(TEXT("Duplex"), DuplexPort);
+		SenderSocket = ReceiverSocket;
+		CommandEncoder.SetTypeTags(true);
+		return ReceiverSocket != nullptr;
 	}
-	ReceiverAddr->SetPort(Config.ReceiverPort);
+	CommandEncoder.SetTypeTags(false);
 
-	// Create receiver socket as BLOCKING for reliable connection
-	ReceiverSocket = FTcpSocketBuilder(TEXT("AefDeepSyncReceiver"))
-		.AsReusable()
-		.Build();
-	
+	ReceiverSocket = OpenConnection(TEXT("Receiver"), Config.ReceiverPort);
 	if (!ReceiverSocket)
 	{
-		if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Error, TEXT("Failed to create receiver socket"));
 		return false;
 	}
 
-	// Set non-blocking for the connect attempt, then wait
-	ReceiverSocket->SetNonBlocking(true);
-	bool bConnectStarted = ReceiverSocket->Connect(*ReceiverAddr);
-	
-	if (!bConnectStarted)
+	SenderSocket = OpenConnection(TEXT("Sender"), Config.SenderPort);
+	if (!SenderSocket)
 	{
-		if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Error, TEXT("Failed to initiate connection to %s:%d"), *Config.ServerIP, Config.ReceiverPort);
 		DisconnectFromServer();
 		return false;
 	}
+	return true;
+}
 
-	// Wait for connection to complete (WaitForWrite indicates connection ready)
-	if (!ReceiverSocket->Wait(ESocketWaitConditions::WaitForWrite, FTimespan::FromSeconds(5.0)))
+FSocket* UAefDeepSyncSubsystem::OpenConnection(const TCHAR* Name, int32 Port)
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSubsystem)
 	{
-		if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Error, TEXT("Connection timeout to %s:%d"), *Config.ServerIP, Config.ReceiverPort);
-		DisconnectFromServer();
-		return false;
+		if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Error, TEXT("Socket subsystem unavailable"));
+		return nullptr;
 	}
 
-	// Verify connection state
-	ESocketConnectionState ConnState = ReceiverSocket->GetConnectionState();
-	if (ConnState != ESocketConnectionState::SCS_Connected)
+	TSharedRef<FInternetAddr> Addr = SocketSubsystem->CreateInternetAddr();
+	bool bIsValid = false;
+	Addr->SetIp(*Config.ServerIP, bIsValid);
+	if (!bIsValid)
 	{
-		if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Error, TEXT("[Receiver] Connection failed (state=%d)"), static_cast<int32>(ConnState));
-		DisconnectFromServer();
-		return false;
+		if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Error, TEXT("Invalid IP: %s"), *Config.ServerIP);
+		return nullptr;
 	}
+	Addr->SetPort(Port);
 
-	if (Config.bLogConnectionStatus) UE_LOG(LogAefDeepSync, Log, TEXT("[Receiver] Connected to %s:%d"), *Config.ServerIP, Config.ReceiverPort);
-
-	// Create sender socket address
-	TSharedRef<FInternetAddr> SenderAddr = SocketSubsystem->CreateInternetAddr();
-	SenderAddr->SetIp(*Config.ServerIP, bIsValid);
-	SenderAddr->SetPort(Config.SenderPort);
-
-	// Create sender socket - use BLOCKING connect for reliable handshake
-	SenderSocket = FTcpSocketBuilder(TEXT("AefDeepSyncSender"))
+	FSocket* Socket = FTcpSocketBuilder(*FString::Printf(TEXT("AefDeepSync%s"), Name))
 		.AsReusable()
-		.AsBlocking()  // Connect in blocking mode
 		.Build();
-	
-	if (!SenderSocket)
+
+	if (!Socket)
 	{
-		if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Error, TEXT("Failed to create sender socket"));
-		DisconnectFromServer();
-		return false;
+		if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Error, TEXT("[%s] Failed to create socket"), Name);
+		return nullptr;
 	}
 
-	// Blocking connect with timeout
-	bool bConnectResult = SenderSocket->Connect(*SenderAddr);
-	
-	if (Config.bLogConnectionStatus)
+	auto Fail = [SocketSubsystem, Socket]() -> FSocket*
 	{
-		UE_LOG(LogAefDeepSync, Log, TEXT("[Sender] Connect() to %s:%d returned %s"), 
-			*Config.ServerIP, Config.SenderPort, bConnectResult ? TEXT("true") : TEXT("false"));
-	}
+		Socket->Close();
+		SocketSubsystem->DestroySocket(Socket);
+		return nullptr;
+	};
 
-	if (!bConnectResult)
+	// Set non-blocking for the connect attempt, then wait
+	Socket->SetNonBlocking(true);
+	if (!Socket->Connect(*Addr))
 	{
-		if (Config.bLogNetworkErrors) 
-		{
-			UE_LOG(LogAefDeepSync, Error, TEXT("[Sender] Connection failed to %s:%d"), *Config.ServerIP, Config.SenderPort);
-		}
-		DisconnectFromServer();
-		return false;
+		if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Error, TEXT("[%s] Failed to initiate connection to %s:%d"), Name, *Config.ServerIP, Port);
+		return Fail();
 	}
 
-	// Verify sender connection state
-	ESocketConnectionState SenderConnState = SenderSocket->GetConnectionState();
-	if (SenderConnState != ESocketConnectionState::SCS_Connected)
+	// Wait for connection to complete (WaitForWrite indicates connection ready)
+	if (!Socket->Wait(ESocketWaitConditions::WaitForWrite, FTimespan::FromSeconds(5.0)))
 	{
-		if (Config.bLogNetworkErrors) 
-		{
-			UE_LOG(LogAefDeepSync, Error, TEXT("[Sender] Connection not established (state=%d)"), 
-				static_cast<int32>(SenderConnState));
-		}
-		DisconnectFromServer();
-		return false;
+		if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Error, TEXT("[%s] Connection timeout to %s:%d"), Name, *Config.ServerIP, Port);
+		return Fail();
 	}
 
-	// Now switch to non-blocking for send operations
-	SenderSocket->SetNonBlocking(true);
-
-	if (Config.bLogConnectionStatus)
+	// Verify connection state
+	const ESocketConnectionState ConnState = Socket->GetConnectionState();
+	if (ConnState != ESocketConnectionState::SCS_Connected)
 	{
-		UE_LOG(LogAefDeepSync, Log, TEXT("[Sender] Connected to %s:%d"), *Config.ServerIP, Config.SenderPort);
+		if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Error, TEXT("[%s] Connection failed (state=%d)"), Name, static_cast<int32>(ConnState));
+		return Fail();
 	}
-	return true;
+
+	if (Config.bLogConnectionStatus) UE_LOG(LogAefDeepSync, Log, TEXT("[%s] Connected to %s:%d"), Name, *Config.ServerIP, Port);
+	return Socket;
 }
 
 void UAefDeepSyncSubsystem::DisconnectFromServer()
 {
+	if (SenderSocket == ReceiverSocket)
+	{
+		// Duplex connection, closed once as the receiver
+		SenderSocket = nullptr;
+	}
 	if (ReceiverSocket)
 	{
 		ReceiverSocket->Close();
@@ -306,10 +458,26 @@ void UAefDeepSyncSubsystem::DisconnectFromServer()
 		SenderSocket = nullptr;
 	}
 	ReceiveBuffer.Empty();
+	SendBuffer.Reset();
+	PendingCommandWaits.Reset();
+	bSendFailed = false;
+
+	// Critical commands (IDs) go out on the next connection, the rest was meant for this one
+	ClearCommandLanes(true);
+
+	// ID job timeouts stand still until the connection is back
+	if (IdJobs.Num() > 0 && IdJobsPausedSince == 0.0)
+	{
+		IdJobsPausedSince = FPlatformTime::Seconds();
+	}
+	ResetHeartbeat();
 }
 
 void UAefDeepSyncSubsystem::ProcessReceivedData()
 {
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_Receive);
+	CSV_SCOPED_TIMING_STAT(AefDeepSync, Receive);
+
 	if (!ReceiverSocket) return;
 
 	// Check for pending data
@@ -343,9 +511,27 @@ void UAefDeepSyncSubsystem::ProcessReceivedData()
 		return;
 	}
 
-	ReceiveBuffer += FString(BytesRead, UTF8_TO_TCHAR(ReceivedData.GetData()));
+	LastReceiveTime = FPlatformTime::Seconds();
+	CaptureWriter.Write(ReceivedData.GetData(), BytesRead);
+	ConsumeReceivedBytes(ReceivedData.GetData(), BytesRead, LastReceiveTime * 1000.0);
+}
+
+void UAefDeepSyncSubsystem::ConsumeReceivedBytes(const uint8* Data, int32 Num, double ArrivalMs)
+{
+	// Convert exactly Num bytes, the receive buffer is not null-terminated
+	FAefTraceMessageStages TraceStages;
+	if (AEFDEEPSYNC_TRACE_CHANNEL_ENABLED())
+	{
+		TraceStages.ReceivedCycle = FPlatformTime::Cycles64();
+	}
+	TRACE_AEFDEEPSYNC(OutputReceive(Num));
+
+	FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Data), Num);
+	ReceiveBuffer.AppendChars(Converter.Get(), Converter.Length());
+	INC_DWORD_STAT_BY(STAT_AefDeepSync_BytesReceived, Num);
+	FrameBytesReceived += Num;
 
-	if (Config.bLogWearableUpdated) UE_LOG(LogAefDeepSync, Log, TEXT("Received %d bytes: %s"), BytesRead, *ReceiveBuffer);
+	if (Config.bLogWearableUpdated) UE_LOG(LogAefDeepSync, Log, TEXT("Received %d bytes: %s"), Num, *ReceiveBuffer);
 
 	// Parse messages (delimiter: 'X')
 	int32 DelimiterIndex = 0;
@@ -356,18 +542,50 @@ void UAefDeepSyncSubsystem::ProcessReceivedData()
 
 		if (JsonMessage.IsEmpty()) continue;
 
+		if (AEFDEEPSYNC_TRACE_CHANNEL_ENABLED())
+		{
+			TraceStages.FramedCycle = FPlatformTime::Cycles64();
+		}
+
 		if (Config.bLogWearableUpdated) UE_LOG(LogAefDeepSync, Log, TEXT("Parsing JSON: %s"), *JsonMessage);
 
+		INC_DWORD_STAT(STAT_AefDeepSync_Messages);
+		++FrameMessageCount;
+
+		// Wearable data has no type tag, everything else (duplex replies, pongs) leads with one
+		if ((Config.bDuplexConnection || Config.bHeartbeat) && JsonMessage.StartsWith(TEXT("{\"type\":"), ESearchCase::CaseSensitive))
+		{
+			HandleControlMessage(JsonMessage);
+			continue;
+		}
+
 		FAefDeepSyncWearableData WearableData;
-		if (ParseWearableMessage(JsonMessage, WearableData) && IsWearableIdAllowed(WearableData.WearableId))
+		if (!ParseWearableMessage(JsonMessage, WearableData))
+		{
+			INC_DWORD_STAT(STAT_AefDeepSync_ParseFailures);
+			continue;
+		}
+		if (IsWearableIdAllowed(WearableData.WearableId))
 		{
+			if (AEFDEEPSYNC_TRACE_CHANNEL_ENABLED())
+			{
+				TraceStages.ParsedCycle = FPlatformTime::Cycles64();
+			}
+
+			MeasureLatency(WearableData, ArrivalMs);
 			UpdateWearable(WearableData);
+
+			TRACE_AEFDEEPSYNC(OutputMessage(TraceStages, WearableData.WearableId, WearableData.Timestamp, JsonMessage.Len()));
+			TRACE_AEFDEEPSYNC(OutputHeartRate(WearableData.WearableId, WearableData.HeartRate));
 		}
 	}
 }
 
 bool UAefDeepSyncSubsystem::ParseWearableMessage(const FString& JsonMessage, FAefDeepSyncWearableData& OutData)
 {
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_Parse);
+	TRACE_AEFDEEPSYNC_SCOPE(AefDeepSync_Parse);
+
 	TSharedPtr<FJsonObject> JsonObject;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonMessage);
 
@@ -392,367 +610,2277 @@ bool UAefDeepSyncSubsystem::ParseWearableMessage(const FString& JsonMessage, FAe
 	return true;
 }
 
+void UAefDeepSyncSubsystem::HandleControlMessage(const FString& JsonMessage)
+{
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonMessage);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		INC_DWORD_STAT(STAT_AefDeepSync_ParseFailures);
+		return;
+	}
+
+	const FString Type = JsonObject->GetStringField(TEXT("type"));
+	if (Type == TEXT("pong") && Config.bHeartbeat)
+	{
+		HandlePong(JsonObject->GetIntegerField(TEXT("Seq")));
+		return;
+	}
+	UE_LOG(LogAefDeepSync, Verbose, TEXT("Control message ignored: %s"), *JsonMessage);
+}
+
 void UAefDeepSyncSubsystem::SetConnectionStatus(EAefDeepSyncConnectionStatus NewStatus)
 {
 	if (ConnectionStatus != NewStatus)
 	{
 		ConnectionStatus = NewStatus;
-		if (Config.bLogConnectionStatus)
+
+		const TCHAR* StatusName = TEXT("Unknown");
+		switch (NewStatus)
 		{
-			const TCHAR* StatusName = TEXT("Unknown");
-			switch (NewStatus)
-			{
-				case EAefDeepSyncConnectionStatus::Disconnected: StatusName = TEXT("Disconnected"); break;
-				case EAefDeepSyncConnectionStatus::Connecting: StatusName = TEXT("Connecting"); break;
-				case EAefDeepSyncConnectionStatus::Connected: StatusName = TEXT("Connected"); break;
-				case EAefDeepSyncConnectionStatus::Reconnecting: StatusName = TEXT("Reconnecting"); break;
-				case EAefDeepSyncConnectionStatus::Failed: StatusName = TEXT("Failed"); break;
-			}
-			UE_LOG(LogAefDeepSync, Log, TEXT("Connection status: %s"), StatusName);
+			case EAefDeepSyncConnectionStatus::Disconnected: StatusName = TEXT("Disconnected"); break;
+			case EAefDeepSyncConnectionStatus::Connecting: StatusName = TEXT("Connecting"); break;
+			case EAefDeepSyncConnectionStatus::Connected: StatusName = TEXT("Connected"); break;
+			case EAefDeepSyncConnectionStatus::Reconnecting: StatusName = TEXT("Reconnecting"); break;
+			case EAefDeepSyncConnectionStatus::Failed: StatusName = TEXT("Failed"); break;
 		}
+		if (Config.bLogConnectionStatus) UE_LOG(LogAefDeepSync, Log, TEXT("Connection status: %s"), StatusName);
+		TRACE_AEFDEEPSYNC(OutputConnectionStatus(StatusName));
 		OnConnectionStatusChanged.Broadcast(NewStatus);
 	}
 }
 
 //--------------------------------------------------------------------------------
-// Wearable Management
+// Heartbeat
 //--------------------------------------------------------------------------------
 
-TArray<FAefDeepSyncWearableData> UAefDeepSyncSubsystem::GetActiveWearables() const
-{
-	TArray<FAefDeepSyncWearableData> Result;
-	ActiveWearables.GenerateValueArray(Result);
-	return Result;
-}
-
-bool UAefDeepSyncSubsystem::GetWearableById(int32 WearableId, FAefDeepSyncWearableData& OutData) const
+float UAefDeepSyncSubsystem::GetTimeSinceLastReceive() const
 {
-	const FAefDeepSyncWearableData* Found = ActiveWearables.Find(WearableId);
-	if (Found)
+	if (ConnectionStatus != EAefDeepSyncConnectionStatus::Connected || LastReceiveTime <= 0.0)
 	{
-		OutData = *Found;
-		return true;
+		return 0.0f;
 	}
-	return false;
+	return static_cast<float>(FPlatformTime::Seconds() - LastReceiveTime);
 }
 
-void UAefDeepSyncSubsystem::UpdateWearable(const FAefDeepSyncWearableData& Data)
+void UAefDeepSyncSubsystem::TickHeartbeat(float DeltaTime)
 {
-	const double CurrentTime = GetWorld() ? GetWorld()->GetTimeSeconds() : FPlatformTime::Seconds();
-
-	FAefDeepSyncWearableData* Existing = ActiveWearables.Find(Data.WearableId);
-	if (Existing)
-	{
-		Existing->HeartRate = Data.HeartRate;
-		Existing->Color = Data.Color;
-		Existing->Timestamp = Data.Timestamp;
-		Existing->TimeSinceLastUpdate = 0.0f;
-		Existing->LastUpdateWorldTime = CurrentTime;
+	// The receive above may already have dropped the connection
+	if (ConnectionStatus != EAefDeepSyncConnectionStatus::Connected) return;
 
-		if (Config.bLogWearableUpdated) UE_LOG(LogAefDeepSync, Verbose, TEXT("Updated: %s"), *Existing->ToString());
-		OnWearableUpdated.Broadcast(Data.WearableId, *Existing);
-	}
-	else
+	const double Now = FPlatformTime::Seconds();
+	if (LastReceiveTime <= 0.0)
 	{
-		FAefDeepSyncWearableData NewWearable = Data;
-		NewWearable.UniqueId = NextUniqueId++;
-		NewWearable.TimeSinceLastUpdate = 0.0f;
-		NewWearable.LastUpdateWorldTime = CurrentTime;
-		ActiveWearables.Add(Data.WearableId, NewWearable);
-
-		if (Config.bLogWearableConnected) UE_LOG(LogAefDeepSync, Log, TEXT("New wearable: %s"), *NewWearable.ToString());
-		OnWearableConnected.Broadcast(NewWearable);
+		// First tick on this connection, the server gets a full timeout to start sending
+		LastReceiveTime = Now;
 	}
-}
-
-void UAefDeepSyncSubsystem::CheckWearableTimeouts(float DeltaTime)
-{
-	TArray<int32> WearablesToRemove;
 
-	for (auto& Pair : ActiveWearables)
+	// A half-open TCP connection never fails a receive, only the silence gives it away. Armed by
+	// the first pong: a server without pong support may stay silent in an empty scene.
+	const float Silence = static_cast<float>(Now - LastReceiveTime);
+	if (bHeartbeatArmed && Config.HeartbeatTimeout > 0.0f)
 	{
-		Pair.Value.TimeSinceLastUpdate += DeltaTime;
-		if (Pair.Value.IsStale(Config.WearableLostTimeout))
+		if (Silence > Config.HeartbeatTimeout)
 		{
-			WearablesToRemove.Add(Pair.Key);
+			if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Warning, TEXT("Heartbeat: nothing received for %.1fs"), Silence);
+			SetConnectionStatus(EAefDeepSyncConnectionStatus::Reconnecting);
+			DisconnectFromServer();
+			ReconnectTimer = Config.ReconnectDelay;
+			return;
 		}
-	}
 
-	for (int32 WearableId : WearablesToRemove)
-	{
-		FAefDeepSyncWearableData LostWearable;
-		if (ActiveWearables.RemoveAndCopyValue(WearableId, LostWearable))
+		// Half the timeout without a byte warns before the connection is dropped
+		const bool bDegraded = Silence > 0.5f * Config.HeartbeatTimeout;
+		if (bDegraded != bConnectionDegraded)
 		{
-			if (Config.bLogWearableLost) UE_LOG(LogAefDeepSync, Log, TEXT("Wearable lost (timeout): %s"), *LostWearable.ToString());
-			OnWearableLost.Broadcast(LostWearable);
+			bConnectionDegraded = bDegraded;
+			if (Config.bLogConnectionStatus)
+			{
+				UE_LOG(LogAefDeepSync, Log, TEXT("Heartbeat: connection %s (%.1fs silent, RTT %.1f ms)"),
+					bDegraded ? TEXT("degraded") : TEXT("recovered"), Silence, HeartbeatRttMs);
+			}
+			OnConnectionHealthChanged.Broadcast(bDegraded, HeartbeatRttMs);
+
+			// Handlers may stop or restart DeepSync
+			if (ConnectionStatus != EAefDeepSyncConnectionStatus::Connected) return;
 		}
 	}
+
+	HeartbeatTimer -= DeltaTime;
+	if (HeartbeatTimer > 0.0f || !SenderSocket) return;
+	HeartbeatTimer = FMath::Max(Config.HeartbeatInterval, 0.05f);
+
+	// Pings bypass the command lanes, a full queue must not delay them
+	const int32 Seq = NextPingSeq++;
+	CommandEncoder.Reset();
+	CommandEncoder.AppendPingCommand(Seq);
+	int32 BytesSent = 0;
+	if (!SendCommandBytes(CommandEncoder.GetData(), CommandEncoder.Num(), BytesSent))
+	{
+		if (Config.bLogNetworkErrors) UE_LOG(LogAefDeepSync, Warning, TEXT("Heartbeat: ping send failed"));
+		SetConnectionStatus(EAefDeepSyncConnectionStatus::Reconnecting);
+		DisconnectFromServer();
+		ReconnectTimer = Config.ReconnectDelay;
+		return;
+	}
+	PingSendTimes[Seq % NumPingSlots] = Now;
 }
 
-bool UAefDeepSyncSubsystem::IsWearableIdAllowed(int32 WearableId) const
+void UAefDeepSyncSubsystem::HandlePong(int32 Seq)
 {
-	// If no filter configured, allow any ID
-	if (Config.AllowedWearableIds.Num() == 0)
-		return true;
-	return Config.AllowedWearableIds.Contains(WearableId);
+	// Ignore pongs of an earlier connection or of a ping whose slot was reused
+	if (Seq < FMath::Max(0, NextPingSeq - NumPingSlots) || Seq >= NextPingSeq) return;
+
+	double& SendTime = PingSendTimes[Seq % NumPingSlots];
+	if (SendTime <= 0.0) return;
+
+	const float RttMs = static_cast<float>((FPlatformTime::Seconds() - SendTime) * 1000.0);
+	SendTime = 0.0;
+
+	// Smoothed like TCP's SRTT (1/8 of each new sample)
+	HeartbeatRttMs = HeartbeatRttMs < 0.0f ? RttMs : HeartbeatRttMs + 0.125f * (RttMs - HeartbeatRttMs);
+	bHeartbeatArmed = true;
+	UE_LOG(LogAefDeepSync, Verbose, TEXT("Heartbeat: pong %d, RTT %.1f ms"), Seq, RttMs);
+}
+
+void UAefDeepSyncSubsystem::ResetHeartbeat()
+{
+	LastReceiveTime = 0.0;
+	HeartbeatTimer = 0.0f;
+	NextPingSeq = 0;
+	FMemory::Memzero(PingSendTimes);
+	HeartbeatRttMs = -1.0f;
+	bHeartbeatArmed = false;
+
+	// Ends with the connection, OnConnectionStatusChanged reports the drop
+	bConnectionDegraded = false;
 }
 
 //--------------------------------------------------------------------------------
-// Commands
+// Capture & Replay
 //--------------------------------------------------------------------------------
 
-bool UAefDeepSyncSubsystem::SendColorCommandLinear(int32 WearableId, FLinearColor InColor)
+bool UAefDeepSyncSubsystem::StartCapture(const FString& FilePath)
 {
-	// Convert to internal color struct
-	FAefDeepSyncColor ColorStruct;
-	ColorStruct.R = static_cast<uint8>(FMath::Clamp(InColor.R * 255.0f, 0.0f, 255.0f));
-	ColorStruct.G = static_cast<uint8>(FMath::Clamp(InColor.G * 255.0f, 0.0f, 255.0f));
-	ColorStruct.B = static_cast<uint8>(FMath::Clamp(InColor.B * 255.0f, 0.0f, 255.0f));
-	return SendColorCommand(WearableId, ColorStruct);
-}
+	const FString CapturePath = FilePath.IsEmpty()
+		? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AefDeepSync"),
+			FString::Printf(TEXT("DeepSync_%s.capture"), *FDateTime::Now().ToString()))
+		: FilePath;
 
-bool UAefDeepSyncSubsystem::SendColorCommand(int32 WearableId, FAefDeepSyncColor InColor)
-{
-	if (!SenderSocket)
+	if (!CaptureWriter.Open(CapturePath))
 	{
-		UE_LOG(LogAefDeepSync, Warning, TEXT("Cannot send - SenderSocket is null"));
 		return false;
 	}
 
-	if (ConnectionStatus != EAefDeepSyncConnectionStatus::Connected)
-	{
+	if (Config.bLogConnectionStatus) UE_LOG(LogAefDeepSync, Log, TEXT("Capture started: %s"), *CapturePath);
+	return true;
+}
+
+void UAefDeepSyncSubsystem::StopCapture()
+{
+	if (!CaptureWriter.IsOpen()) return;
+
+	const int64 CapturedBytes = CaptureWriter.GetCapturedBytes();
+	CaptureWriter.Close();
+	if (Config.bLogConnectionStatus) UE_LOG(LogAefDeepSync, Log, TEXT("Capture stopped (%lld bytes)"), CapturedBytes);
+}
+
+bool UAefDeepSyncSubsystem::StartReplay(const FString& FilePath, float Speed)
+{
+	if (bWantsToRun)
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("StartReplay called but DeepSync is running - call StopDeepSync first"));
+		return false;
+	}
+
+	if (!ReplayReader.Open(FilePath))
+	{
+		return false;
+	}
+
+	if (!ReplayReader.Next(PendingReplayChunk))
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("Replay: %s contains no data"), *FilePath);
+		ReplayReader.Close();
+		return false;
+	}
+
+	// Skip the silence between starting the capture and the first data
+	bHasPendingReplayChunk = true;
+	ReplayClockMicros = static_cast<double>(PendingReplayChunk.TimeMicros);
+	ReplaySpeed = FMath::Max(Speed, 0.01f);
+	bReplaying = true;
+	bWantsToRun = true;
+
+	if (Config.bLogConnectionStatus) UE_LOG(LogAefDeepSync, Log, TEXT("Replay started: %s (%.2fx)"), *FilePath, ReplaySpeed);
+	SetConnectionStatus(EAefDeepSyncConnectionStatus::Connected);
+	return true;
+}
+
+void UAefDeepSyncSubsystem::ProcessReplayData(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_Receive);
+	CSV_SCOPED_TIMING_STAT(AefDeepSync, Receive);
+
+	ReplayClockMicros += static_cast<double>(DeltaTime) * ReplaySpeed * 1.0e6;
+
+	// Chunk data points into the mapped window, consume it before reading the next chunk
+	while (bReplaying && bHasPendingReplayChunk && PendingReplayChunk.TimeMicros <= ReplayClockMicros)
+	{
+		// Recorded arrival time, wall clock would scale latency and clock drift with the replay speed
+		ConsumeReceivedBytes(PendingReplayChunk.Data, PendingReplayChunk.Num, PendingReplayChunk.TimeMicros / 1000.0);
+		bHasPendingReplayChunk = bReplaying && ReplayReader.Next(PendingReplayChunk);
+	}
+
+	if (bReplaying && !bHasPendingReplayChunk)
+	{
+		if (Config.bLogConnectionStatus) UE_LOG(LogAefDeepSync, Log, TEXT("Replay finished"));
+		StopDeepSync();
+	}
+}
+
+//--------------------------------------------------------------------------------
+// Wearable Management
+//--------------------------------------------------------------------------------
+
+TArray<FAefDeepSyncWearableData> UAefDeepSyncSubsystem::GetActiveWearables() const
+{
+	TArray<FAefDeepSyncWearableData> Result;
+	ActiveWearables.GenerateValueArray(Result);
+	return Result;
+}
+
+bool UAefDeepSyncSubsystem::GetWearableById(int32 WearableId, FAefDeepSyncWearableData& OutData) const
+{
+	const FAefDeepSyncWearableData* Found = ActiveWearables.Find(WearableId);
+	if (Found)
+	{
+		OutData = *Found;
+		return true;
+	}
+	return false;
+}
+
+void UAefDeepSyncSubsystem::UpdateWearable(const FAefDeepSyncWearableData& Data)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_Dispatch);
+	TRACE_AEFDEEPSYNC_SCOPE(AefDeepSync_Dispatch);
+
+	if (ColorProbes.Num() > 0)
+	{
+		ConfirmColorProbes(Data);
+	}
+	if (IdJobs.Num() > 0)
+	{
+		ObserveIdProvisioning(Data.WearableId);
+	}
+
+	if (bHoldWearableTimeouts)
+	{
+		ResumeWearableTimeouts(TEXT("data received"));
+	}
+
+	const double CurrentTime = GetWorld() ? GetWorld()->GetTimeSeconds() : FPlatformTime::Seconds();
+
+	FAefDeepSyncWearableData* Existing = ActiveWearables.Find(Data.WearableId);
+	if (Existing)
+	{
+		Existing->HeartRate = Data.HeartRate;
+		Existing->Color = Data.Color;
+		Existing->Timestamp = Data.Timestamp;
+		Existing->ServerTime = Data.ServerTime;
+		Existing->LatencyMs = Data.LatencyMs;
+		Existing->TimeSinceLastUpdate = 0.0f;
+		Existing->LastUpdateWorldTime = CurrentTime;
+
+		if (Config.bLogWearableUpdated) UE_LOG(LogAefDeepSync, Verbose, TEXT("Updated: %s"), *Existing->ToString());
+		OnWearableUpdated.Broadcast(Data.WearableId, *Existing);
+	}
+	else
+	{
+		FAefDeepSyncWearableData NewWearable = Data;
+		int32 JournalUniqueId = -1;
+		NewWearable.UniqueId = JournalUniqueIds.RemoveAndCopyValue(Data.WearableId, JournalUniqueId) ? JournalUniqueId : NextUniqueId++;
+		NewWearable.TimeSinceLastUpdate = 0.0f;
+		NewWearable.LastUpdateWorldTime = CurrentTime;
+		ActiveWearables.Add(Data.WearableId, NewWearable);
+
+		if (Config.bLogWearableConnected) UE_LOG(LogAefDeepSync, Log, TEXT("New wearable: %s"), *NewWearable.ToString());
+		OnWearableConnected.Broadcast(NewWearable);
+	}
+
+	if (ColorTargets.Num() > 0)
+	{
+		UpdateColorTarget(Data);
+	}
+}
+
+void UAefDeepSyncSubsystem::CheckWearableTimeouts(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_WearableTimeouts);
+
+	TArray<int32> WearablesToRemove;
+	float OldestData = 0.0f;
+
+	for (auto& Pair : ActiveWearables)
+	{
+		Pair.Value.TimeSinceLastUpdate += DeltaTime;
+		OldestData = FMath::Max(OldestData, Pair.Value.TimeSinceLastUpdate);
+		if (Pair.Value.IsStale(Config.WearableLostTimeout))
+		{
+			WearablesToRemove.Add(Pair.Key);
+		}
+	}
+
+	SET_FLOAT_STAT(STAT_AefDeepSync_OldestWearableData, OldestData);
+
+	for (int32 WearableId : WearablesToRemove)
+	{
+		FAefDeepSyncWearableData LostWearable;
+		if (ActiveWearables.RemoveAndCopyValue(WearableId, LostWearable))
+		{
+			WearableLatencyHistograms.Remove(WearableId);
+			if (Config.bLogWearableLost) UE_LOG(LogAefDeepSync, Log, TEXT("Wearable lost (timeout): %s"), *LostWearable.ToString());
+			OnWearableLost.Broadcast(LostWearable);
+		}
+	}
+}
+
+void UAefDeepSyncSubsystem::BeginWearableTimeoutHold()
+{
+	if (!Config.bReconnectGrace || ActiveWearables.Num() == 0) return;
+
+	// Timeouts did not run while reconnecting. Running them now would drop every
+	// wearable before the server had a chance to send, so wait for the first data.
+	bHoldWearableTimeouts = true;
+	WearableTimeoutHoldTimer = Config.ReconnectGraceTimeout;
+
+	if (Config.bLogConnectionStatus)
+	{
+		UE_LOG(LogAefDeepSync, Log, TEXT("Reconnected, holding timeouts of %d wearables until data arrives"), ActiveWearables.Num());
+	}
+}
+
+void UAefDeepSyncSubsystem::ResumeWearableTimeouts(const TCHAR* Reason)
+{
+	bHoldWearableTimeouts = false;
+
+	// Rebase so every wearable gets a full WearableLostTimeout from now on,
+	// only those that really stay silent are reported lost
+	for (auto& Pair : ActiveWearables)
+	{
+		Pair.Value.TimeSinceLastUpdate = 0.0f;
+	}
+
+	if (Config.bLogConnectionStatus)
+	{
+		UE_LOG(LogAefDeepSync, Log, TEXT("Wearable timeouts resumed (%s)"), Reason);
+	}
+}
+
+bool UAefDeepSyncSubsystem::IsWearableIdAllowed(int32 WearableId) const
+{
+	// If no filter configured, allow any ID
+	if (Config.AllowedWearableIds.Num() == 0)
+		return true;
+	return Config.AllowedWearableIds.Contains(WearableId);
+}
+
+//--------------------------------------------------------------------------------
+// Latency
+//--------------------------------------------------------------------------------
+
+void UAefDeepSyncSubsystem::MeasureLatency(FAefDeepSyncWearableData& Data, double ArrivalMs)
+{
+	if (!ServerClock.Unwrap(Data.Timestamp, Data.ServerTime) && Config.bLogConnectionStatus)
+	{
+		UE_LOG(LogAefDeepSync, Log, TEXT("Server clock jumped back (server restart?), clock estimate reset"));
+	}
+
+	if (!Config.bMeasureLatency) return;
+
+	const double LatencyMs = ServerClock.AddSample(Data.ServerTime, ArrivalMs);
+	if (!ServerClock.HasEstimate()) return;
+
+	Data.LatencyMs = static_cast<float>(LatencyMs);
+	LatencyHistogram.Add(LatencyMs);
+	WearableLatencyHistograms.FindOrAdd(Data.WearableId).Add(LatencyMs);
+}
+
+FAefDeepSyncLatencyStats UAefDeepSyncSubsystem::MakeLatencyStats(const FAefLatencyHistogram& Histogram)
+{
+	FAefDeepSyncLatencyStats Stats;
+	Stats.SampleCount = Histogram.GetCount();
+	Stats.MeanMs = static_cast<float>(Histogram.GetMean());
+	Stats.P50Ms = static_cast<float>(Histogram.GetPercentile(0.50));
+	Stats.P95Ms = static_cast<float>(Histogram.GetPercentile(0.95));
+	Stats.P99Ms = static_cast<float>(Histogram.GetPercentile(0.99));
+	Stats.MaxMs = static_cast<float>(Histogram.GetMax());
+	return Stats;
+}
+
+FAefDeepSyncLatencyStats UAefDeepSyncSubsystem::GetLatencyStats() const
+{
+	return MakeLatencyStats(LatencyHistogram);
+}
+
+bool UAefDeepSyncSubsystem::GetWearableLatencyStats(int32 WearableId, FAefDeepSyncLatencyStats& OutStats) const
+{
+	const FAefLatencyHistogram* Histogram = WearableLatencyHistograms.Find(WearableId);
+	if (!Histogram || Histogram->GetCount() == 0)
+	{
+		return false;
+	}
+	OutStats = MakeLatencyStats(*Histogram);
+	return true;
+}
+
+double UAefDeepSyncSubsystem::GetServerClockOffsetMs() const
+{
+	// During replay the estimate lives on the capture timeline
+	const double LocalMs = bReplaying ? ReplayClockMicros / 1000.0 : FPlatformTime::Seconds() * 1000.0;
+	return ServerClock.HasEstimate() ? ServerClock.GetOffsetMs(LocalMs) : 0.0;
+}
+
+void UAefDeepSyncSubsystem::ResetLatencyStats()
+{
+	LatencyHistogram.Reset();
+	WearableLatencyHistograms.Reset();
+}
+
+void UAefDeepSyncSubsystem::AddColorProbe(int32 WearableId, const FAefDeepSyncColor& Color)
+{
+	// A wearable already showing the color cannot confirm the command
+	const FAefDeepSyncWearableData* Wearable = ActiveWearables.Find(WearableId);
+	if (Wearable && FAefDeepSyncColor(Wearable->Color.ToFColor(false)) == Color)
+	{
+		return;
+	}
+
+	auto& Probes = ColorProbes.FindOrAdd(WearableId);
+	if (Probes.Num() >= MaxColorProbesPerWearable)
+	{
+		Probes.RemoveAt(0);
+	}
+	Probes.Add({ Color, FPlatformTime::Seconds() });
+}
+
+void UAefDeepSyncSubsystem::ConfirmColorProbes(const FAefDeepSyncWearableData& Data)
+{
+	auto* Probes = ColorProbes.Find(Data.WearableId);
+	if (!Probes) return;
+
+	const FAefDeepSyncColor ReportedColor(Data.Color.ToFColor(false));
+
+	// Newest matching command wins, older commands were overwritten on the device
+	for (int32 i = Probes->Num() - 1; i >= 0; --i)
+	{
+		if ((*Probes)[i].Color == ReportedColor)
+		{
+			ColorProbeHistogram.Add((FPlatformTime::Seconds() - (*Probes)[i].SentTime) * 1000.0);
+			Probes->RemoveAt(0, i + 1);
+			break;
+		}
+	}
+
+	if (Probes->Num() == 0)
+	{
+		ColorProbes.Remove(Data.WearableId);
+	}
+}
+
+void UAefDeepSyncSubsystem::ExpireColorProbes()
+{
+	const double Now = FPlatformTime::Seconds();
+	for (auto It = ColorProbes.CreateIterator(); It; ++It)
+	{
+		auto& Probes = It.Value();
+		int32 NumExpired = 0;
+		while (NumExpired < Probes.Num() && Now - Probes[NumExpired].SentTime > Config.ColorProbeTimeout)
+		{
+			++NumExpired;
+		}
+
+		if (NumExpired > 0)
+		{
+			ColorProbesUnconfirmed += NumExpired;
+			if (Config.bLogColorCommands)
+			{
+				UE_LOG(LogAefDeepSync, Warning, TEXT("Color cmd: Wearable %d did not report %s within %.1fs"),
+					It.Key(), *Probes[NumExpired - 1].Color.ToString(), Config.ColorProbeTimeout);
+			}
+			Probes.RemoveAt(0, NumExpired);
+			if (Probes.Num() == 0)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+FAefDeepSyncLatencyStats UAefDeepSyncSubsystem::GetColorCommandLatencyStats() const
+{
+	FAefLatencyHistogram Rolling = PreviousColorProbeHistogram;
+	Rolling.Append(ColorProbeHistogram);
+	return MakeLatencyStats(Rolling);
+}
+
+int32 UAefDeepSyncSubsystem::GetPendingColorCommandCount() const
+{
+	int32 Count = 0;
+	for (const auto& Pair : ColorProbes)
+	{
+		Count += Pair.Value.Num();
+	}
+	return Count;
+}
+
+void UAefDeepSyncSubsystem::ResetColorCommandLatencyStats()
+{
+	ColorProbeHistogram.Reset();
+	PreviousColorProbeHistogram.Reset();
+	ColorProbeWindowStart = FPlatformTime::Seconds();
+	ColorProbesUnconfirmed = 0;
+}
+
+//--------------------------------------------------------------------------------
+// Commands
+//--------------------------------------------------------------------------------
+
+bool UAefDeepSyncSubsystem::CanSendCommand() const
+{
+	if (!SenderSocket)
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("Cannot send - SenderSocket is null"));
+		return false;
+	}
+
+	if (ConnectionStatus != EAefDeepSyncConnectionStatus::Connected)
+	{
 		UE_LOG(LogAefDeepSync, Warning, TEXT("Cannot send - not connected (status=%d)"), static_cast<int32>(ConnectionStatus));
 		return false;
 	}
 
-	// Check socket connection state
-	ESocketConnectionState SocketState = SenderSocket->GetConnectionState();
-	if (SocketState != ESocketConnectionState::SCS_Connected)
+	if (bSendFailed)
+	{
+		UE_LOG(LogAefDeepSync, Verbose, TEXT("Cannot send - command connection lost, reconnecting"));
+		return false;
+	}
+
+	// Check socket connection state
+	ESocketConnectionState SocketState = SenderSocket->GetConnectionState();
+	if (SocketState != ESocketConnectionState::SCS_Connected)
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("Cannot send - SenderSocket not connected (state=%d)"), static_cast<int32>(SocketState));
+		return false;
+	}
+	return true;
+}
+
+bool UAefDeepSyncSubsystem::SendCommandBytes(const uint8* Data, int32 Num, int32& OutBytesSent)
+{
+	OutBytesSent = 0;
+	if (bSendFailed)
+	{
+		return false;
+	}
+
+	// Earlier bytes are still waiting, these go behind them to keep the stream in order
+	if (SendBuffer.Num() == 0)
+	{
+		OutBytesSent = WriteToSenderSocket(Data, Num);
+		if (bSendFailed)
+		{
+			// Part of a command may be on the stream, only a new connection gets the server back in sync
+			return false;
+		}
+		if (OutBytesSent == Num)
+		{
+			return true;
+		}
+	}
+
+	// The non-blocking socket took only part, the rest goes out from Tick
+	if (SendBuffer.Num() + Num - OutBytesSent > MaxSendBacklog)
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("Send failed - server does not read commands (%d bytes pending)"), SendBuffer.Num());
+		bSendFailed = true;
+		return false;
+	}
+	SendBuffer.Append(Data + OutBytesSent, Num - OutBytesSent);
+	return true;
+}
+
+void UAefDeepSyncSubsystem::FlushSendBuffer()
+{
+	if (!SenderSocket || bSendFailed) return;
+
+	const int32 Written = WriteToSenderSocket(SendBuffer.GetData(), SendBuffer.Num());
+	if (Written <= 0)
+	{
+		return;
+	}
+	SendBuffer.RemoveAt(0, Written, EAllowShrinking::No);
+
+	// Lane commands have waited until their last byte is on the socket
+	const double Now = FPlatformTime::Seconds();
+	int32 NumWritten = 0;
+	for (FAefPendingCommandWait& Pending : PendingCommandWaits)
+	{
+		Pending.EndOffset -= Written;
+		if (Pending.EndOffset <= 0)
+		{
+			CommandLanes[Pending.Lane].WaitHistogram.Add((Now - Pending.EnqueueTime) * 1000.0);
+			++NumWritten;
+		}
+	}
+	PendingCommandWaits.RemoveAt(0, NumWritten, EAllowShrinking::No);
+}
+
+int32 UAefDeepSyncSubsystem::WriteToSenderSocket(const uint8* Data, int32 Num)
+{
+	// Non-blocking: write what the socket takes now, never wait on the game thread
+	int32 Written = 0;
+	while (Written < Num)
+	{
+		int32 Sent = 0;
+		const bool bSent = SenderSocket->Send(Data + Written, Num - Written, Sent);
+		Written += FMath::Max(0, Sent);
+		if (bSent && Sent > 0)
+		{
+			continue;
+		}
+
+		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+		const ESocketErrors LastError = bSent ? SE_EWOULDBLOCK : (SocketSubsystem ? SocketSubsystem->GetLastErrorCode() : SE_NO_ERROR);
+		if (LastError != SE_EWOULDBLOCK)
+		{
+			// Get socket error for diagnostics
+			const FString ErrorString = SocketSubsystem ? SocketSubsystem->GetSocketError(LastError) : TEXT("Unknown");
+			UE_LOG(LogAefDeepSync, Warning, TEXT("Send failed - Socket error: %s (code=%d, BytesSent=%d of %d)"),
+				*ErrorString, static_cast<int32>(LastError), Written, Num);
+			bSendFailed = true;
+		}
+		break;
+	}
+	return Written;
+}
+
+bool UAefDeepSyncSubsystem::SendColorCommandLinear(int32 WearableId, FLinearColor InColor)
+{
+	return SendColorCommand(WearableId, FAefDeepSyncColor::FromLinearColor(InColor));
+}
+
+bool UAefDeepSyncSubsystem::SendColorCommand(int32 WearableId, FAefDeepSyncColor InColor)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_SendCommand);
+
+	if (Config.bCommandLanes)
+	{
+		FAefQueuedCommand Command;
+		Command.WearableId = WearableId;
+		Command.Color = InColor;
+		return QueueCommand(EAefCommandPriority::Normal, MoveTemp(Command));
+	}
+
+	if (!CanSendCommand())
+	{
+		return false;
+	}
+
+	CommandEncoder.Reset();
+	CommandEncoder.AppendColorCommand(WearableId, InColor);
+	int32 BytesSent = 0;
+
+	UE_LOG(LogAefDeepSync, Verbose, TEXT("Sending: %s (%d bytes)"), *CommandEncoder.ToString(), CommandEncoder.Num());
+
+	if (!SendCommandBytes(CommandEncoder.GetData(), CommandEncoder.Num(), BytesSent))
+	{
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_AefDeepSync_CommandsSent);
+	if (Config.bProbeColorCommands)
+	{
+		AddColorProbe(WearableId, InColor);
+	}
+	if (Config.bLogColorCommands) UE_LOG(LogAefDeepSync, Log, TEXT("Color cmd: Wearable %d -> %s (%d bytes sent)"), WearableId, *InColor.ToString(), BytesSent);
+	return true;
+}
+
+bool UAefDeepSyncSubsystem::SendColorCommandToWearables(const TArray<int32>& WearableIds, FLinearColor InColor)
+{
+	return SendColorCommandToIds(WearableIds, FAefDeepSyncColor::FromLinearColor(InColor));
+}
+
+bool UAefDeepSyncSubsystem::SendColorCommandToAll(FLinearColor InColor)
+{
+	TArray<int32, TInlineAllocator<128>> WearableIds;
+	ActiveWearables.GenerateKeyArray(WearableIds);
+	return SendColorCommandToIds(WearableIds, FAefDeepSyncColor::FromLinearColor(InColor));
+}
+
+bool UAefDeepSyncSubsystem::SendColorCommandToGroup(FName GroupName, FLinearColor InColor)
+{
+	const TArray<int32>* Group = Config.ColorGroups.Find(GroupName);
+	if (!Group)
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("Cannot send - unknown color group '%s'"), *GroupName.ToString());
+		return false;
+	}
+	return SendColorCommandToIds(*Group, FAefDeepSyncColor::FromLinearColor(InColor));
+}
+
+bool UAefDeepSyncSubsystem::SendColorCommandToIds(TConstArrayView<int32> WearableIds, FAefDeepSyncColor InColor)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_SendCommand);
+
+	if (WearableIds.Num() == 0)
+	{
+		return true;
+	}
+
+	if (Config.bCommandLanes)
+	{
+		FAefQueuedCommand Command;
+		Command.Color = InColor;
+		Command.GroupIds.Append(WearableIds.GetData(), WearableIds.Num());
+		return QueueCommand(EAefCommandPriority::Normal, MoveTemp(Command));
+	}
+
+	if (!CanSendCommand())
+	{
+		return false;
+	}
+
+	// All commands go into one buffer and one write
+	CommandEncoder.Reset();
+	if (Config.bServerGroupCommands)
+	{
+		CommandEncoder.AppendGroupColorCommand(WearableIds, InColor);
+	}
+	else
+	{
+		for (int32 WearableId : WearableIds)
+		{
+			CommandEncoder.AppendColorCommand(WearableId, InColor);
+		}
+	}
+
+	int32 BytesSent = 0;
+	if (!SendCommandBytes(CommandEncoder.GetData(), CommandEncoder.Num(), BytesSent))
+	{
+		return false;
+	}
+
+	INC_DWORD_STAT_BY(STAT_AefDeepSync_CommandsSent, WearableIds.Num());
+	if (Config.bProbeColorCommands)
+	{
+		for (int32 WearableId : WearableIds)
+		{
+			AddColorProbe(WearableId, InColor);
+		}
+	}
+	if (Config.bLogColorCommands) UE_LOG(LogAefDeepSync, Log, TEXT("Color cmd: %d wearables -> %s (%d bytes sent)"), WearableIds.Num(), *InColor.ToString(), BytesSent);
+	return true;
+}
+
+TArray<FName> UAefDeepSyncSubsystem::GetColorGroupNames() const
+{
+	TArray<FName> Names;
+	Config.ColorGroups.GenerateKeyArray(Names);
+	return Names;
+}
+
+TArray<int32> UAefDeepSyncSubsystem::GetColorGroup(FName GroupName) const
+{
+	const TArray<int32>* Group = Config.ColorGroups.Find(GroupName);
+	return Group ? *Group : TArray<int32>();
+}
+
+bool UAefDeepSyncSubsystem::SendIdCommand(int32 WearableId, int32 NewId)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_SendCommand);
+
+	if (Config.bCommandLanes)
+	{
+		FAefQueuedCommand Command;
+		Command.WearableId = WearableId;
+		Command.NewId = NewId;
+		return QueueCommand(EAefCommandPriority::Critical, MoveTemp(Command));
+	}
+
+	if (!CanSendCommand())
+	{
+		return false;
+	}
+
+	CommandEncoder.Reset();
+	CommandEncoder.AppendIdCommand(WearableId, NewId);
+	int32 BytesSent = 0;
+
+	UE_LOG(LogAefDeepSync, Verbose, TEXT("Sending: %s (%d bytes)"), *CommandEncoder.ToString(), CommandEncoder.Num());
+
+	if (!SendCommandBytes(CommandEncoder.GetData(), CommandEncoder.Num(), BytesSent))
+	{
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_AefDeepSync_CommandsSent);
+	if (Config.bLogIdCommands) UE_LOG(LogAefDeepSync, Log, TEXT("ID cmd: Wearable %d -> NewId %d (%d bytes sent)"), WearableId, NewId, BytesSent);
+	return true;
+}
+
+//--------------------------------------------------------------------------------
+// Command Lanes
+//--------------------------------------------------------------------------------
+
+bool UAefDeepSyncSubsystem::SendColorCommandWithPriority(int32 WearableId, FLinearColor InColor, EAefCommandPriority Priority)
+{
+	const FAefDeepSyncColor Color = FAefDeepSyncColor::FromLinearColor(InColor);
+	if (!Config.bCommandLanes)
+	{
+		return SendColorCommand(WearableId, Color);
+	}
+
+	FAefQueuedCommand Command;
+	Command.WearableId = WearableId;
+	Command.Color = Color;
+	return QueueCommand(Priority, MoveTemp(Command));
+}
+
+int32 UAefDeepSyncSubsystem::GetCommandQueueDepth(EAefCommandPriority Priority) const
+{
+	return CommandLanes[FMath::Clamp(static_cast<int32>(Priority), 0, NumCommandLanes - 1)].Num();
+}
+
+FAefDeepSyncLatencyStats UAefDeepSyncSubsystem::GetCommandWaitStats(EAefCommandPriority Priority) const
+{
+	return MakeLatencyStats(CommandLanes[FMath::Clamp(static_cast<int32>(Priority), 0, NumCommandLanes - 1)].WaitHistogram);
+}
+
+void UAefDeepSyncSubsystem::ResetCommandWaitStats()
+{
+	for (FAefCommandLane& Lane : CommandLanes)
+	{
+		Lane.WaitHistogram.Reset();
+	}
+}
+
+bool UAefDeepSyncSubsystem::QueueCommand(EAefCommandPriority Priority, FAefQueuedCommand&& Command)
+{
+	if (!CanSendCommand())
+	{
+		return false;
+	}
+
+	FAefCommandLane& Lane = CommandLanes[FMath::Clamp(static_cast<int32>(Priority), 0, NumCommandLanes - 1)];
+	const bool bSingleColor = Command.NewId < 0 && Command.GroupIds.Num() == 0;
+
+	// Only the newest animation color matters, it keeps the place (and wait time) of the queued one
+	if (Priority == EAefCommandPriority::Background && bSingleColor)
+	{
+		if (const int32* QueuedIndex = Lane.QueuedColorIndex.Find(Command.WearableId))
+		{
+			Lane.Queue[*QueuedIndex].Color = Command.Color;
+			return true;
+		}
+		Lane.QueuedColorIndex.Add(Command.WearableId, Lane.Queue.Num());
+	}
+
+	Command.EnqueueTime = FPlatformTime::Seconds();
+	Lane.Queue.Add(MoveTemp(Command));
+	return true;
+}
+
+void UAefDeepSyncSubsystem::FlushCommandLanes()
+{
+	if (CommandLanes[0].Num() == 0 && CommandLanes[1].Num() == 0 && CommandLanes[2].Num() == 0)
+	{
+		return;
+	}
+
+	// While earlier bytes wait for the socket, commands stay in their lanes: a later
+	// critical command can still overtake them and background colors keep coalescing
+	if (SendBuffer.Num() > 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_SendCommand);
+
+	const double Now = FPlatformTime::Seconds();
+	const int32 Budgets[NumCommandLanes] = { Config.CriticalCommandBudget, Config.NormalCommandBudget, Config.BackgroundCommandBudget };
+	TArray<TPair<int32, FAefDeepSyncColor>, TInlineAllocator<64>> SentColors;
+	TArray<int32, TInlineAllocator<64>> CommandEnds;
+	int32 NumCommands = 0;
+
+	// Higher lanes first, each up to its budget, all in one write
+	int32 Taken[NumCommandLanes] = {};
+	CommandEncoder.Reset();
+	for (int32 LaneIndex = 0; LaneIndex < NumCommandLanes; ++LaneIndex)
+	{
+		FAefCommandLane& Lane = CommandLanes[LaneIndex];
+		while (Lane.Head + Taken[LaneIndex] < Lane.Queue.Num() && (Budgets[LaneIndex] <= 0 || Taken[LaneIndex] < Budgets[LaneIndex]))
+		{
+			const FAefQueuedCommand& Command = Lane.Queue[Lane.Head + Taken[LaneIndex]++];
+
+			if (Command.NewId >= 0)
+			{
+				CommandEncoder.AppendIdCommand(Command.WearableId, Command.NewId);
+				++NumCommands;
+			}
+			else if (Command.GroupIds.Num() > 0)
+			{
+				if (Config.bServerGroupCommands)
+				{
+					CommandEncoder.AppendGroupColorCommand(Command.GroupIds, Command.Color);
+				}
+				for (int32 WearableId : Command.GroupIds)
+				{
+					if (!Config.bServerGroupCommands)
+					{
+						CommandEncoder.AppendColorCommand(WearableId, Command.Color);
+					}
+					SentColors.Emplace(WearableId, Command.Color);
+				}
+				NumCommands += Command.GroupIds.Num();
+			}
+			else
+			{
+				CommandEncoder.AppendColorCommand(Command.WearableId, Command.Color);
+				SentColors.Emplace(Command.WearableId, Command.Color);
+				++NumCommands;
+			}
+			CommandEnds.Add(CommandEncoder.Num());
+		}
+	}
+
+	// Commands leave their lane only once written, a failed write keeps them queued
+	int32 BytesSent = 0;
+	if (!SendCommandBytes(CommandEncoder.GetData(), CommandEncoder.Num(), BytesSent))
+	{
+		return;
+	}
+
+	// The send buffer was empty, a tail the socket did not take starts at its front
+	int32 CommandIndex = 0;
+	for (int32 LaneIndex = 0; LaneIndex < NumCommandLanes; ++LaneIndex)
+	{
+		FAefCommandLane& Lane = CommandLanes[LaneIndex];
+		for (int32 i = 0; i < Taken[LaneIndex]; ++i)
+		{
+			const double EnqueueTime = Lane.Queue[Lane.Head++].EnqueueTime;
+			const int32 EndOffset = CommandEnds[CommandIndex++] - BytesSent;
+			if (EndOffset <= 0)
+			{
+				Lane.WaitHistogram.Add((Now - EnqueueTime) * 1000.0);
+			}
+			else
+			{
+				PendingCommandWaits.Add({ LaneIndex, EndOffset, EnqueueTime });
+			}
+		}
+
+		if (Lane.Head == Lane.Queue.Num())
+		{
+			Lane.Queue.Reset();
+			Lane.QueuedColorIndex.Reset();
+			Lane.Head = 0;
+		}
+		else if (Lane.Head > 0 && (Lane.QueuedColorIndex.Num() > 0 || Lane.Head * 2 > Lane.Queue.Num()))
+		{
+			// Drop the written commands, indices of the replaceable ones shift with them
+			const bool bReplaceable = Lane.QueuedColorIndex.Num() > 0;
+			Lane.Queue.RemoveAt(0, Lane.Head, EAllowShrinking::No);
+			Lane.Head = 0;
+			Lane.QueuedColorIndex.Reset();
+			for (int32 Index = 0; bReplaceable && Index < Lane.Queue.Num(); ++Index)
+			{
+				const FAefQueuedCommand& Command = Lane.Queue[Index];
+				if (Command.NewId < 0 && Command.GroupIds.Num() == 0)
+				{
+					Lane.QueuedColorIndex.Add(Command.WearableId, Index);
+				}
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_AefDeepSync_CommandsSent, NumCommands);
+	if (Config.bProbeColorCommands)
+	{
+		for (const TPair<int32, FAefDeepSyncColor>& Pair : SentColors)
+		{
+			AddColorProbe(Pair.Key, Pair.Value);
+		}
+	}
+	UE_LOG(LogAefDeepSync, Verbose, TEXT("Command lanes: %d commands (%d bytes sent), queued %d/%d/%d"),
+		NumCommands, BytesSent, CommandLanes[0].Num(), CommandLanes[1].Num(), CommandLanes[2].Num());
+}
+
+void UAefDeepSyncSubsystem::ClearCommandLanes(bool bKeepCritical)
+{
+	const int32 FirstLane = bKeepCritical ? 1 : 0;
+	int32 NumDropped = 0;
+	for (int32 LaneIndex = FirstLane; LaneIndex < NumCommandLanes; ++LaneIndex)
+	{
+		NumDropped += CommandLanes[LaneIndex].Num();
+	}
+	if (NumDropped > 0 && Config.bLogNetworkErrors)
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("Command lanes: %d queued commands dropped, %d critical kept for the next connection"),
+			NumDropped, FirstLane > 0 ? CommandLanes[0].Num() : 0);
+	}
+
+	for (int32 LaneIndex = FirstLane; LaneIndex < NumCommandLanes; ++LaneIndex)
+	{
+		FAefCommandLane& Lane = CommandLanes[LaneIndex];
+		Lane.Queue.Reset();
+		Lane.QueuedColorIndex.Reset();
+		Lane.Head = 0;
+	}
+}
+
+//--------------------------------------------------------------------------------
+// Color Reconciliation
+//--------------------------------------------------------------------------------
+
+void UAefDeepSyncSubsystem::SetTargetColor(int32 WearableId, FLinearColor InColor)
+{
+	const FAefDeepSyncColor Color = FAefDeepSyncColor::FromLinearColor(InColor);
+
+	FAefColorTarget* Existing = ColorTargets.Find(WearableId);
+	if (Existing && Existing->Color == Color)
+	{
+		return;
+	}
+
+	FAefColorTarget& Target = Existing ? *Existing : ColorTargets.Add(WearableId);
+	Target.Color = Color;
+	Target.Attempts = 0;
+	Target.NextSendTime = 0.0;
+
+	const FAefDeepSyncWearableData* Wearable = ActiveWearables.Find(WearableId);
+	Target.bReached = Wearable && FAefDeepSyncColor(Wearable->Color.ToFColor(false)) == Color;
+
+	// Send right away if the budget allows, otherwise the next tick picks it up
+	if (!Target.bReached && Wearable && !bReplaying && ConnectionStatus == EAefDeepSyncConnectionStatus::Connected &&
+		(Config.ColorReconcileRate <= 0.0f || ColorReconcileBudget >= 1.0f))
+	{
+		SendColorTarget(WearableId, Target, FPlatformTime::Seconds());
+	}
+}
+
+void UAefDeepSyncSubsystem::ClearTargetColor(int32 WearableId)
+{
+	ColorTargets.Remove(WearableId);
+}
+
+void UAefDeepSyncSubsystem::ClearAllTargetColors()
+{
+	ColorTargets.Empty();
+}
+
+bool UAefDeepSyncSubsystem::GetTargetColor(int32 WearableId, FLinearColor& OutColor) const
+{
+	const FAefColorTarget* Target = ColorTargets.Find(WearableId);
+	if (!Target) return false;
+	OutColor = Target->Color.ToLinearColor();
+	return true;
+}
+
+bool UAefDeepSyncSubsystem::IsTargetColorReached(int32 WearableId) const
+{
+	const FAefColorTarget* Target = ColorTargets.Find(WearableId);
+	return Target && Target->bReached;
+}
+
+int32 UAefDeepSyncSubsystem::GetPendingTargetColorCount() const
+{
+	int32 Count = 0;
+	for (const auto& Pair : ColorTargets)
+	{
+		if (!Pair.Value.bReached) ++Count;
+	}
+	return Count;
+}
+
+void UAefDeepSyncSubsystem::UpdateColorTarget(const FAefDeepSyncWearableData& Data)
+{
+	FAefColorTarget* Target = ColorTargets.Find(Data.WearableId);
+	if (!Target) return;
+
+	const bool bMatches = FAefDeepSyncColor(Data.Color.ToFColor(false)) == Target->Color;
+	if (bMatches && !Target->bReached)
+	{
+		if (Config.bLogColorCommands && Target->Attempts > 1)
+		{
+			UE_LOG(LogAefDeepSync, Log, TEXT("Color target: Wearable %d reached %s after %d attempts"),
+				Data.WearableId, *Target->Color.ToString(), Target->Attempts);
+		}
+		Target->bReached = true;
+		Target->Attempts = 0;
+	}
+	else if (!bMatches && Target->bReached)
+	{
+		// Device lost the color (reset, other sender), start over
+		Target->bReached = false;
+		Target->NextSendTime = 0.0;
+	}
+}
+
+void UAefDeepSyncSubsystem::ReconcileColorTargets(float DeltaTime)
+{
+	const bool bRateLimited = Config.ColorReconcileRate > 0.0f;
+	if (bRateLimited)
+	{
+		// Bursts are capped at one second worth of commands
+		ColorReconcileBudget = FMath::Min(ColorReconcileBudget + Config.ColorReconcileRate * DeltaTime,
+			FMath::Max(1.0f, Config.ColorReconcileRate));
+	}
+
+	// Round robin: start where the budget ran out last tick, so under sustained drift
+	// wearables late in the map get their turn too (second pass wraps around)
+	const int32 Start = ColorReconcileCursor < ColorTargets.Num() ? ColorReconcileCursor : 0;
+	ColorReconcileCursor = 0;
+
+	const double Now = FPlatformTime::Seconds();
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		int32 Index = -1;
+		for (auto& Pair : ColorTargets)
+		{
+			++Index;
+			if ((Pass == 0) != (Index >= Start))
+			{
+				continue;
+			}
+
+			FAefColorTarget& Target = Pair.Value;
+			// A playing effect overrides the target until it ends
+			if (Target.bReached || Now < Target.NextSendTime || !ActiveWearables.Contains(Pair.Key) || LedEffects.Contains(Pair.Key))
+			{
+				continue;
+			}
+			if (bRateLimited && ColorReconcileBudget < 1.0f)
+			{
+				ColorReconcileCursor = Index;
+				return;
+			}
+			SendColorTarget(Pair.Key, Target, Now);
+		}
+	}
+}
+
+bool UAefDeepSyncSubsystem::SendColorTarget(int32 WearableId, FAefColorTarget& Target, double Now)
+{
+	if (!SendColorCommand(WearableId, Target.Color))
+	{
+		// Not sent, nothing charged; try again after the base delay
+		Target.NextSendTime = Now + Config.ColorRetryDelay;
+		return false;
+	}
+
+	// Exponential backoff until the wearable reports the color
+	const float Delay = Config.ColorRetryDelay * static_cast<float>(1 << FMath::Min(Target.Attempts, 10));
+	Target.NextSendTime = Now + FMath::Min(Delay, Config.ColorRetryMaxDelay);
+	++Target.Attempts;
+	ColorReconcileBudget -= 1.0f;
+
+	if (Config.bLogColorCommands && Target.Attempts > 1)
+	{
+		UE_LOG(LogAefDeepSync, Log, TEXT("Color target: Wearable %d retry %d for %s"), WearableId, Target.Attempts - 1, *Target.Color.ToString());
+	}
+
+	INC_DWORD_STAT(STAT_AefDeepSync_ColorReconcileCommands);
+	return true;
+}
+
+//--------------------------------------------------------------------------------
+// LED Effects
+//--------------------------------------------------------------------------------
+
+void UAefDeepSyncSubsystem::PlayLedEffect(int32 WearableId, const FAefLedEffect& Effect)
+{
+	StopLedEffect(WearableId);
+
+	FAefLedEffectState& State = LedEffects.Add(WearableId);
+	State.Start(Effect, FPlatformTime::Seconds());
+	if (Config.bServerEffects)
+	{
+		State.bUploaded = UploadLedEffect(WearableId, &Effect);
+	}
+}
+
+void UAefDeepSyncSubsystem::StopLedEffect(int32 WearableId)
+{
+	FAefLedEffectState State;
+	if (LedEffects.RemoveAndCopyValue(WearableId, State) && State.bUploaded)
+	{
+		UploadLedEffect(WearableId, nullptr);
+	}
+}
+
+void UAefDeepSyncSubsystem::StopAllLedEffects()
+{
+	TArray<int32> WearableIds;
+	LedEffects.GenerateKeyArray(WearableIds);
+	for (int32 WearableId : WearableIds)
+	{
+		StopLedEffect(WearableId);
+	}
+}
+
+void UAefDeepSyncSubsystem::TickLedEffects(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_LedEffects);
+
+	// Fixed command rate, independent of the frame rate
+	const float StepInterval = 1.0f / FMath::Max(Config.EffectCommandRate, 1.0f);
+	LedEffectStepTimer += DeltaTime;
+	if (LedEffectStepTimer < StepInterval)
+	{
+		return;
+	}
+	LedEffectStepTimer = FMath::Fmod(LedEffectStepTimer, StepInterval);
+
+	const double Now = FPlatformTime::Seconds();
+	TArray<TPair<int32, FAefDeepSyncColor>, TInlineAllocator<64>> Changed;
+	for (auto It = LedEffects.CreateIterator(); It; ++It)
+	{
+		FAefLedEffectState& State = It.Value();
+		const FAefDeepSyncWearableData* Wearable = ActiveWearables.Find(It.Key());
+
+		bool bFinished = false;
+		const FAefDeepSyncColor Color = State.Step(Now, Wearable ? Wearable->HeartRate : 0, bFinished);
+		State.bFinished |= bFinished;
+
+		// Quantized: nothing is sent while the 8-bit output stays the same
+		const bool bPending = !State.bUploaded && (!State.bHasSent || Color != State.LastSent);
+		if (bPending && Wearable)
+		{
+			Changed.Emplace(It.Key(), Color);
+		}
+
+		// A finished effect stays until its final color went out (send succeeded). Without the
+		// wearable there is nobody to show it, a color target takes over once it is back.
+		if (State.bFinished && (!bPending || !Wearable))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// LastSent only moves on success, a failed batch is sent again on the next step
+	if (Changed.Num() > 0 && SendColorCommandBatch(Changed))
+	{
+		INC_DWORD_STAT_BY(STAT_AefDeepSync_LedEffectCommands, Changed.Num());
+		for (const TPair<int32, FAefDeepSyncColor>& Pair : Changed)
+		{
+			FAefLedEffectState& State = LedEffects[Pair.Key];
+			if (State.bFinished)
+			{
+				LedEffects.Remove(Pair.Key);
+				continue;
+			}
+			State.LastSent = Pair.Value;
+			State.bHasSent = true;
+		}
+	}
+}
+
+bool UAefDeepSyncSubsystem::UploadLedEffect(int32 WearableId, const FAefLedEffect* Effect)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_SendCommand);
+
+	if (!CanSendCommand())
+	{
+		return false;
+	}
+
+	TAnsiStringBuilder<256> Command;
+	if (Effect)
+	{
+		const FAefDeepSyncColor From = FAefDeepSyncColor::FromLinearColor(Effect->FromColor);
+		const FAefDeepSyncColor To = FAefDeepSyncColor::FromLinearColor(Effect->ToColor);
+		Command.Appendf("{\"type\":\"effect\",\"Id\":%d,\"Effect\":\"%s\",\"From\":{\"R\":%d,\"G\":%d,\"B\":%d},\"To\":{\"R\":%d,\"G\":%d,\"B\":%d},\"Duration\":%.3f,\"Repeat\":%d}X",
+			WearableId, Effect->GetTypeName(), From.R, From.G, From.B, To.R, To.G, To.B, Effect->Duration, Effect->Repeat);
+	}
+	else
+	{
+		Command.Appendf("{\"type\":\"effect\",\"Id\":%d,\"Effect\":\"none\"}X", WearableId);
+	}
+
+	int32 BytesSent = 0;
+	if (!SendCommandBytes(reinterpret_cast<const uint8*>(Command.GetData()), Command.Len(), BytesSent))
+	{
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_AefDeepSync_CommandsSent);
+	INC_DWORD_STAT(STAT_AefDeepSync_LedEffectCommands);
+	if (Config.bLogColorCommands) UE_LOG(LogAefDeepSync, Log, TEXT("Effect cmd: Wearable %d -> %s (%d bytes sent)"), WearableId, ANSI_TO_TCHAR(Effect ? Effect->GetTypeName() : "none"), BytesSent);
+	return true;
+}
+
+bool UAefDeepSyncSubsystem::SendColorCommandBatch(TConstArrayView<TPair<int32, FAefDeepSyncColor>> Commands)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_SendCommand);
+
+	if (Config.bCommandLanes)
+	{
+		bool bQueued = true;
+		for (const TPair<int32, FAefDeepSyncColor>& Pair : Commands)
+		{
+			FAefQueuedCommand Command;
+			Command.WearableId = Pair.Key;
+			Command.Color = Pair.Value;
+			bQueued &= QueueCommand(EAefCommandPriority::Background, MoveTemp(Command));
+		}
+		return bQueued;
+	}
+
+	if (!CanSendCommand())
+	{
+		return false;
+	}
+
+	CommandEncoder.Reset();
+	for (const TPair<int32, FAefDeepSyncColor>& Pair : Commands)
+	{
+		CommandEncoder.AppendColorCommand(Pair.Key, Pair.Value);
+	}
+
+	int32 BytesSent = 0;
+	if (!SendCommandBytes(CommandEncoder.GetData(), CommandEncoder.Num(), BytesSent))
+	{
+		return false;
+	}
+
+	INC_DWORD_STAT_BY(STAT_AefDeepSync_CommandsSent, Commands.Num());
+	if (Config.bProbeColorCommands)
+	{
+		for (const TPair<int32, FAefDeepSyncColor>& Pair : Commands)
+		{
+			AddColorProbe(Pair.Key, Pair.Value);
+		}
+	}
+	UE_LOG(LogAefDeepSync, Verbose, TEXT("Color batch: %d commands (%d bytes sent)"), Commands.Num(), BytesSent);
+	return true;
+}
+
+//--------------------------------------------------------------------------------
+// ID Provisioning
+//--------------------------------------------------------------------------------
+
+bool UAefDeepSyncSubsystem::StartIdProvisioning(const TMap<int32, int32>& OldToNewIds)
+{
+	if (IdJobs.Num() > 0)
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("ID provisioning already running (%d/%d done)"), IdJobsSucceeded + IdJobsFailed, IdJobs.Num());
+		return false;
+	}
+
+	// A new ID that is still in use could be confirmed by the wrong device
+	TSet<int32> NewIds;
+	for (const TPair<int32, int32>& Pair : OldToNewIds)
+	{
+		bool bAlreadyInSet = false;
+		NewIds.Add(Pair.Value, &bAlreadyInSet);
+		if (Pair.Key == Pair.Value || bAlreadyInSet || ActiveWearables.Contains(Pair.Value) || OldToNewIds.Contains(Pair.Value))
+		{
+			UE_LOG(LogAefDeepSync, Warning, TEXT("ID provisioning rejected: NewId %d for Wearable %d is in use or not unique"), Pair.Value, Pair.Key);
+			return false;
+		}
+
+		// Updates of a filtered ID never reach UpdateWearable, the job could only time out
+		if (!IsWearableIdAllowed(Pair.Value))
+		{
+			UE_LOG(LogAefDeepSync, Warning, TEXT("ID provisioning rejected: NewId %d for Wearable %d is not in allowedWearableIds"), Pair.Value, Pair.Key);
+			return false;
+		}
+	}
+
+	IdJobs.Reserve(OldToNewIds.Num());
+	for (const TPair<int32, int32>& Pair : OldToNewIds)
+	{
+		FAefIdJob& Job = IdJobs.AddDefaulted_GetRef();
+		Job.OldId = Pair.Key;
+		Job.NewId = Pair.Value;
+		IdJobsByWearable.Add(Job.OldId, IdJobs.Num() - 1);
+		IdJobsByWearable.Add(Job.NewId, IdJobs.Num() - 1);
+	}
+
+	if (Config.bLogIdCommands) UE_LOG(LogAefDeepSync, Log, TEXT("ID provisioning started: %d wearables, %d in flight"), IdJobs.Num(), Config.IdProvisioningInFlight);
+	return IdJobs.Num() > 0;
+}
+
+void UAefDeepSyncSubsystem::CancelIdProvisioning()
+{
+	if (IdJobs.Num() > 0 && Config.bLogIdCommands)
+	{
+		UE_LOG(LogAefDeepSync, Log, TEXT("ID provisioning cancelled: %d succeeded, %d failed, %d open"),
+			IdJobsSucceeded, IdJobsFailed, IdJobs.Num() - IdJobsSucceeded - IdJobsFailed);
+	}
+
+	IdJobs.Reset();
+	IdJobsByWearable.Reset();
+	IdJobsNextQueued = 0;
+	IdJobsInFlight = 0;
+	IdJobsSucceeded = 0;
+	IdJobsFailed = 0;
+	IdJobsPausedSince = 0.0;
+}
+
+void UAefDeepSyncSubsystem::GetIdProvisioningProgress(int32& OutSucceeded, int32& OutFailed, int32& OutTotal) const
+{
+	OutSucceeded = IdJobsSucceeded;
+	OutFailed = IdJobsFailed;
+	OutTotal = IdJobs.Num();
+}
+
+void UAefDeepSyncSubsystem::ObserveIdProvisioning(int32 WearableId)
+{
+	const int32* JobIndex = IdJobsByWearable.Find(WearableId);
+	if (!JobIndex)
+	{
+		return;
+	}
+
+	FAefIdJob& Job = IdJobs[*JobIndex];
+	if (Job.State != EAefIdJobState::Sent)
+	{
+		return;
+	}
+
+	if (WearableId == Job.NewId)
+	{
+		if (Job.NewIdSeenTime == 0.0)
+		{
+			Job.NewIdSeenTime = FPlatformTime::Seconds();
+		}
+	}
+	else
+	{
+		// Old ID still sending, the device has not switched (yet)
+		Job.NewIdSeenTime = 0.0;
+	}
+}
+
+void UAefDeepSyncSubsystem::TickIdProvisioning()
+{
+	const double Now = FPlatformTime::Seconds();
+	TArray<FAefIdJob, TInlineAllocator<16>> Finished;
+
+	if (IdJobsPausedSince > 0.0)
+	{
+		// Back after a reconnect: sent jobs keep the rest of their timeout, the new ID has to show up again
+		const double Paused = Now - IdJobsPausedSince;
+		for (FAefIdJob& Job : IdJobs)
+		{
+			if (Job.State == EAefIdJobState::Sent)
+			{
+				Job.SentTime += Paused;
+				Job.NewIdSeenTime = 0.0;
+			}
+		}
+		IdJobsPausedSince = 0.0;
+	}
+
+	for (FAefIdJob& Job : IdJobs)
+	{
+		if (Job.State != EAefIdJobState::Sent)
+		{
+			continue;
+		}
+
+		if (Job.NewIdSeenTime > 0.0 && Now - Job.NewIdSeenTime >= Config.IdProvisioningConfirmTime)
+		{
+			FinishIdJob(Job, true);
+			Finished.Add(Job);
+		}
+		else if (Now - Job.SentTime >= Config.IdProvisioningTimeout)
+		{
+			if (Job.Attempts > Config.IdProvisioningRetries)
+			{
+				FinishIdJob(Job, false);
+				Finished.Add(Job);
+			}
+			else
+			{
+				if (Config.bLogIdCommands) UE_LOG(LogAefDeepSync, Log, TEXT("ID provisioning: Wearable %d -> %d not confirmed, retry %d"), Job.OldId, Job.NewId, Job.Attempts);
+				++Job.Attempts;
+				Job.SentTime = Now;
+				SendIdCommand(Job.OldId, Job.NewId);
+			}
+		}
+	}
+
+	// Keep the pipeline full, a failed send is retried after the timeout like a lost one
+	const int32 MaxInFlight = FMath::Max(1, Config.IdProvisioningInFlight);
+	while (IdJobsInFlight < MaxInFlight && IdJobsNextQueued < IdJobs.Num())
+	{
+		FAefIdJob& Job = IdJobs[IdJobsNextQueued++];
+		Job.State = EAefIdJobState::Sent;
+		Job.Attempts = 1;
+		Job.SentTime = Now;
+		++IdJobsInFlight;
+		SendIdCommand(Job.OldId, Job.NewId);
+	}
+
+	const bool bAllDone = IdJobsSucceeded + IdJobsFailed == IdJobs.Num();
+	const int32 Succeeded = IdJobsSucceeded;
+	const int32 Failed = IdJobsFailed;
+	if (bAllDone)
+	{
+		if (Config.bLogIdCommands) UE_LOG(LogAefDeepSync, Log, TEXT("ID provisioning finished: %d succeeded, %d failed"), Succeeded, Failed);
+		CancelIdProvisioning();
+	}
+
+	// Broadcast last, handlers may start or cancel a job
+	for (const FAefIdJob& Job : Finished)
+	{
+		OnIdProvisioned.Broadcast(Job.OldId, Job.NewId, Job.State == EAefIdJobState::Succeeded);
+	}
+	if (bAllDone)
+	{
+		OnIdProvisioningFinished.Broadcast(Succeeded, Failed);
+	}
+}
+
+void UAefDeepSyncSubsystem::FinishIdJob(FAefIdJob& Job, bool bSuccess)
+{
+	Job.State = bSuccess ? EAefIdJobState::Succeeded : EAefIdJobState::Failed;
+	--IdJobsInFlight;
+	if (bSuccess)
+	{
+		++IdJobsSucceeded;
+	}
+	else
+	{
+		++IdJobsFailed;
+	}
+
+	if (Config.bLogIdCommands)
+	{
+		UE_LOG(LogAefDeepSync, Log, TEXT("ID provisioning: Wearable %d -> %d %s after %d attempt(s)"),
+			Job.OldId, Job.NewId, bSuccess ? TEXT("confirmed") : TEXT("failed"), Job.Attempts);
+	}
+}
+
+//--------------------------------------------------------------------------------
+// Configuration
+//--------------------------------------------------------------------------------
+
+void UAefDeepSyncSubsystem::LoadConfiguration()
+{
+	FString ConfigPath = FPaths::ProjectConfigDir() / TEXT("AefConfig.ini");
+
+	if (!FPaths::FileExists(ConfigPath))
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("AefConfig.ini not found - using defaults"));
+		return;
+	}
+
+	FConfigFile ConfigFile;
+	ConfigFile.Read(ConfigPath);
+	const TCHAR* Section = TEXT("DeepSync");
+
+	auto GetBool = [&](const TCHAR* Key, bool& OutValue) {
+		FString Value;
+		if (ConfigFile.GetString(Section, Key, Value))
+			OutValue = Value.Equals(TEXT("true"), ESearchCase::IgnoreCase);
+	};
+
+	// Startup
+	GetBool(TEXT("autoStart"), Config.bAutoStart);
+
+	// Connection
+	ConfigFile.GetString(Section, TEXT("deepSyncIp"), Config.ServerIP);
+	ConfigFile.GetInt(Section, TEXT("deepSyncReceiverPort"), Config.ReceiverPort);
+	ConfigFile.GetInt(Section, TEXT("deepSyncSenderPort"), Config.SenderPort);
+	GetBool(TEXT("duplexConnection"), Config.bDuplexConnection);
+	ConfigFile.GetInt(Section, TEXT("duplexPort"), Config.DuplexPort);
+
+	// Wearables (no ID restrictions - any positive ID allowed)
+	FString WearableIdsStr;
+	if (ConfigFile.GetString(Section, TEXT("wearableIds"), WearableIdsStr))
+	{
+		TArray<FString> IdStrings;
+		WearableIdsStr.ParseIntoArray(IdStrings, TEXT(","), true);
+		for (const FString& IdStr : IdStrings)
+		{
+			int32 Id = FCString::Atoi(*IdStr.TrimStartAndEnd());
+			if (Id >= 0) Config.AllowedWearableIds.Add(Id);
+		}
+	}
+
+	ConfigFile.GetFloat(Section, TEXT("wearableLostTimeout"), Config.WearableLostTimeout);
+
+	// Reconnection
+	ConfigFile.GetFloat(Section, TEXT("reconnectDelay"), Config.ReconnectDelay);
+	ConfigFile.GetInt(Section, TEXT("maxReconnectAttempts"), Config.MaxReconnectAttempts);
+	GetBool(TEXT("reconnectGrace"), Config.bReconnectGrace);
+	ConfigFile.GetFloat(Section, TEXT("reconnectGraceTimeout"), Config.ReconnectGraceTimeout);
+	GetBool(TEXT("heartbeat"), Config.bHeartbeat);
+	ConfigFile.GetFloat(Section, TEXT("heartbeatInterval"), Config.HeartbeatInterval);
+	ConfigFile.GetFloat(Section, TEXT("heartbeatTimeout"), Config.HeartbeatTimeout);
+
+	// Sync zones
+	FString ZoneDetectionModeStr;
+	if (ConfigFile.GetString(Section, TEXT("zoneDetectionMode"), ZoneDetectionModeStr))
+	{
+		Config.ZoneDetectionMode = ZoneDetectionModeStr.TrimStartAndEnd().Equals(TEXT("spatialHash"), ESearchCase::IgnoreCase)
+			? EAefZoneDetectionMode::SpatialHash
+			: EAefZoneDetectionMode::Overlap;
+	}
+	ConfigFile.GetFloat(Section, TEXT("zoneHashCellSize"), Config.ZoneHashCellSize);
+	GetBool(TEXT("globalZoneAssignment"), Config.bGlobalZoneAssignment);
+	ConfigFile.GetFloat(Section, TEXT("linkGraceWindow"), Config.LinkGraceWindow);
+	ConfigFile.GetFloat(Section, TEXT("linkRelinkRadius"), Config.LinkRelinkRadius);
+	ConfigFile.GetFloat(Section, TEXT("trackHandoffWindow"), Config.TrackHandoffWindow);
+	ConfigFile.GetFloat(Section, TEXT("trackHandoffRadius"), Config.TrackHandoffRadius);
+
+	// Warm-start journal
+	GetBool(TEXT("journalEnabled"), Config.bJournalEnabled);
+	ConfigFile.GetString(Section, TEXT("journalFile"), Config.JournalFile);
+	ConfigFile.GetFloat(Section, TEXT("journalRestoreWindow"), Config.JournalRestoreWindow);
+	ConfigFile.GetFloat(Section, TEXT("journalSnapshotInterval"), Config.JournalSnapshotInterval);
+
+	// Capture & replay
+	ConfigFile.GetString(Section, TEXT("captureFile"), Config.CaptureFile);
+	ConfigFile.GetString(Section, TEXT("replayFile"), Config.ReplayFile);
+	ConfigFile.GetFloat(Section, TEXT("replaySpeed"), Config.ReplaySpeed);
+
+	// Latency
+	GetBool(TEXT("measureLatency"), Config.bMeasureLatency);
+	ConfigFile.GetFloat(Section, TEXT("latencyOffsetWindow"), Config.LatencyOffsetWindow);
+	ConfigFile.GetInt(Section, TEXT("latencyOffsetWindows"), Config.LatencyOffsetWindows);
+	GetBool(TEXT("probeColorCommands"), Config.bProbeColorCommands);
+	ConfigFile.GetFloat(Section, TEXT("colorProbeTimeout"), Config.ColorProbeTimeout);
+	ConfigFile.GetFloat(Section, TEXT("colorProbeWindow"), Config.ColorProbeWindow);
+
+	// Color reconciliation
+	ConfigFile.GetFloat(Section, TEXT("colorRetryDelay"), Config.ColorRetryDelay);
+	ConfigFile.GetFloat(Section, TEXT("colorRetryMaxDelay"), Config.ColorRetryMaxDelay);
+	ConfigFile.GetFloat(Section, TEXT("colorReconcileRate"), Config.ColorReconcileRate);
+
+	// LED effects
+	ConfigFile.GetFloat(Section, TEXT("effectCommandRate"), Config.EffectCommandRate);
+	GetBool(TEXT("serverEffects"), Config.bServerEffects);
+
+	// Command lanes
+	GetBool(TEXT("commandLanes"), Config.bCommandLanes);
+	ConfigFile.GetInt(Section, TEXT("criticalCommandBudget"), Config.CriticalCommandBudget);
+	ConfigFile.GetInt(Section, TEXT("normalCommandBudget"), Config.NormalCommandBudget);
+	ConfigFile.GetInt(Section, TEXT("backgroundCommandBudget"), Config.BackgroundCommandBudget);
+
+	// ID provisioning
+	ConfigFile.GetInt(Section, TEXT("idProvisioningInFlight"), Config.IdProvisioningInFlight);
+	ConfigFile.GetFloat(Section, TEXT("idProvisioningTimeout"), Config.IdProvisioningTimeout);
+	ConfigFile.GetInt(Section, TEXT("idProvisioningRetries"), Config.IdProvisioningRetries);
+	ConfigFile.GetFloat(Section, TEXT("idProvisioningConfirmTime"), Config.IdProvisioningConfirmTime);
+
+	// Group commands
+	GetBool(TEXT("serverGroupCommands"), Config.bServerGroupCommands);
+	FString ColorGroupsStr;
+	if (ConfigFile.GetString(Section, TEXT("colorGroups"), ColorGroupsStr))
+	{
+		Config.ColorGroups.Reset();
+		TArray<FString> GroupStrings;
+		ColorGroupsStr.ParseIntoArray(GroupStrings, TEXT(";"), true);
+		for (const FString& GroupStr : GroupStrings)
+		{
+			FString GroupName, IdsStr;
+			if (!GroupStr.Split(TEXT(":"), &GroupName, &IdsStr)) continue;
+
+			TArray<int32>& Group = Config.ColorGroups.FindOrAdd(FName(*GroupName.TrimStartAndEnd()));
+			TArray<FString> IdStrings;
+			IdsStr.ParseIntoArray(IdStrings, TEXT(","), true);
+			for (const FString& IdStr : IdStrings)
+			{
+				const int32 Id = FCString::Atoi(*IdStr.TrimStartAndEnd());
+				if (Id >= 0) Group.AddUnique(Id);
+			}
+		}
+	}
+	ServerClock.Configure(Config.LatencyOffsetWindow, Config.LatencyOffsetWindows);
+
+	// Logging
+	GetBool(TEXT("logWearableConnected"), Config.bLogWearableConnected);
+	GetBool(TEXT("logWearableLost"), Config.bLogWearableLost);
+	GetBool(TEXT("logWearableUpdated"), Config.bLogWearableUpdated);
+	GetBool(TEXT("logHeartRateChanges"), Config.bLogHeartRateChanges);
+	GetBool(TEXT("logColorCommands"), Config.bLogColorCommands);
+	GetBool(TEXT("logIdCommands"), Config.bLogIdCommands);
+	GetBool(TEXT("logConnectionStatus"), Config.bLogConnectionStatus);
+	GetBool(TEXT("logSyncEvents"), Config.bLogSyncEvents);
+	GetBool(TEXT("logNetworkErrors"), Config.bLogNetworkErrors);
+}
+
+void UAefDeepSyncSubsystem::ReloadConfiguration()
+{
+	const bool bWasSpatialZoneDetection = UsesSpatialZoneDetection();
+	LoadConfiguration();
+	if (UsesSpatialZoneDetection() != bWasSpatialZoneDetection)
+	{
+		ApplyZoneDetectionMode();
+	}
+	if (Config.bLogConnectionStatus) UE_LOG(LogAefDeepSync, Log, TEXT("Configuration reloaded"));
+}
+
+//--------------------------------------------------------------------------------
+// Zone Management
+//--------------------------------------------------------------------------------
+
+void UAefDeepSyncSubsystem::RegisterZone(AAefPharusDeepSyncZoneActor* Zone)
+{
+	if (!Zone) return;
+
+	// Check if already registered
+	for (const auto& WeakZone : RegisteredZones)
+	{
+		if (WeakZone.Get() == Zone)
+		{
+			UE_LOG(LogAefDeepSync, Warning, TEXT("Zone already registered: WearableId=%d"), Zone->WearableId);
+			return;
+		}
+	}
+
+	RegisteredZones.Add(Zone);
+	bZoneLayoutDirty = true;
+	if (UsesSpatialZoneDetection())
+	{
+		TrackPharusActors(Zone->GetWorld());
+	}
+	UE_LOG(LogAefDeepSync, Log, TEXT("Zone registered: WearableId=%d (Total: %d)"), Zone->WearableId, RegisteredZones.Num());
+	OnZoneRegistered.Broadcast(Zone);
+}
+
+void UAefDeepSyncSubsystem::UnregisterZone(AAefPharusDeepSyncZoneActor* Zone)
+{
+	if (!Zone) return;
+
+	int32 RemoveIndex = -1;
+	for (int32 i = 0; i < RegisteredZones.Num(); ++i)
+	{
+		if (RegisteredZones[i].Get() == Zone)
+		{
+			RemoveIndex = i;
+			break;
+		}
+	}
+
+	if (RemoveIndex >= 0)
+	{
+		// Break any links using this zone
+		for (int32 i = SyncedLinks.Num() - 1; i >= 0; --i)
+		{
+			if (SyncedLinks[i].Zone.Get() == Zone)
+			{
+				BreakLinkInternal(i, TEXT("ZoneUnregistered"));
+			}
+		}
+		for (int32 i = LinkTombstones.Num() - 1; i >= 0; --i)
+		{
+			if (LinkTombstones[i].Link.Zone.Get() == Zone)
+			{
+				ExpireLinkTombstone(i, TEXT("ZoneUnregistered"));
+			}
+		}
+
+		EndZoneSession(Zone);
+		RegisteredZones.RemoveAt(RemoveIndex);
+		bZoneLayoutDirty = true;
+		UE_LOG(LogAefDeepSync, Log, TEXT("Zone unregistered: WearableId=%d (Remaining: %d)"), Zone->WearableId, RegisteredZones.Num());
+		OnZoneUnregistered.Broadcast(Zone);
+
+		if (RegisteredZones.Num() == 0)
+		{
+			StopTrackingPharusActors();
+		}
+	}
+}
+
+void UAefDeepSyncSubsystem::ApplyZoneDetectionMode()
+{
+	const bool bSpatial = UsesSpatialZoneDetection();
+	UWorld* ZoneWorld = nullptr;
+	for (int32 i = RegisteredZones.Num() - 1; i >= 0; --i)
 	{
-		UE_LOG(LogAefDeepSync, Warning, TEXT("Cannot send - SenderSocket not connected (state=%d)"), static_cast<int32>(SocketState));
-		return false;
+		if (AAefPharusDeepSyncZoneActor* Zone = RegisteredZones[i].Get())
+		{
+			Zone->ApplyZoneDetectionMode(bSpatial);
+			ZoneWorld = Zone->GetWorld();
+		}
 	}
 
-	FString JsonCommand = FString::Printf(TEXT("{\"Id\":%d,\"Color\":{\"R\":%d,\"G\":%d,\"B\":%d}}X"),
-		WearableId, InColor.R, InColor.G, InColor.B);
-
-	FTCHARToUTF8 Converter(*JsonCommand);
-	int32 BytesSent = 0;
+	// Zones dropped their tracks above, the occupancy of the old mode is stale
+	StopTrackingPharusActors();
+	bZoneLayoutDirty = true;
+	if (bSpatial && ZoneWorld)
+	{
+		TrackPharusActors(ZoneWorld);
+	}
 
-	UE_LOG(LogAefDeepSync, Verbose, TEXT("Sending: %s (%d bytes)"), *JsonCommand, Converter.Length());
+	UE_LOG(LogAefDeepSync, Log, TEXT("Zone detection switched to %s (%d zones)"),
+		bSpatial ? TEXT("spatial hash") : TEXT("overlap"), RegisteredZones.Num());
+}
 
-	if (!SenderSocket->Send((const uint8*)Converter.Get(), Converter.Length(), BytesSent))
+TArray<AAefPharusDeepSyncZoneActor*> UAefDeepSyncSubsystem::GetAllZones() const
+{
+	TArray<AAefPharusDeepSyncZoneActor*> Result;
+	for (const auto& WeakZone : RegisteredZones)
 	{
-		// Get socket error for diagnostics
-		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-		ESocketErrors LastError = SocketSubsystem ? SocketSubsystem->GetLastErrorCode() : SE_NO_ERROR;
-		FString ErrorString = SocketSubsystem ? SocketSubsystem->GetSocketError(LastError) : TEXT("Unknown");
-		
-		UE_LOG(LogAefDeepSync, Warning, TEXT("Send failed - Socket error: %s (code=%d, BytesSent=%d)"), 
-			*ErrorString, static_cast<int32>(LastError), BytesSent);
-		return false;
+		if (AAefPharusDeepSyncZoneActor* Zone = WeakZone.Get())
+		{
+			Result.Add(Zone);
+		}
 	}
+	return Result;
+}
 
-	if (Config.bLogColorCommands) UE_LOG(LogAefDeepSync, Log, TEXT("Color cmd: Wearable %d -> %s (%d bytes sent)"), WearableId, *InColor.ToString(), BytesSent);
-	return true;
+AAefPharusDeepSyncZoneActor* UAefDeepSyncSubsystem::GetZoneByWearableId(int32 InWearableId) const
+{
+	for (const auto& WeakZone : RegisteredZones)
+	{
+		if (AAefPharusDeepSyncZoneActor* Zone = WeakZone.Get())
+		{
+			if (Zone->WearableId == InWearableId)
+			{
+				return Zone;
+			}
+		}
+	}
+	return nullptr;
 }
 
-bool UAefDeepSyncSubsystem::SendIdCommand(int32 WearableId, int32 NewId)
+//--------------------------------------------------------------------------------
+// Zone Sync Sessions
+//--------------------------------------------------------------------------------
+
+int32 UAefDeepSyncSubsystem::GetSyncingZoneCount() const
 {
-	if (!SenderSocket)
+	int32 Count = 0;
+	for (const FAefZoneSyncSession& Session : ZoneSyncSessions)
 	{
-		UE_LOG(LogAefDeepSync, Warning, TEXT("Cannot send - SenderSocket is null"));
-		return false;
+		const AAefPharusDeepSyncZoneActor* Zone = Session.Zone.Get();
+		if (Zone && Zone->IsSyncing())
+		{
+			++Count;
+		}
 	}
+	return Count;
+}
 
-	if (ConnectionStatus != EAefDeepSyncConnectionStatus::Connected)
+void UAefDeepSyncSubsystem::BeginZoneSession(AAefPharusDeepSyncZoneActor* Zone, AActor* PharusActor)
+{
+	if (!Zone) return;
+
+	// Make sure we hear about the track disappearing (OnEndPlay)
+	AddPharusActor(PharusActor);
+
+	for (const FAefZoneSyncSession& Session : ZoneSyncSessions)
 	{
-		UE_LOG(LogAefDeepSync, Warning, TEXT("Cannot send - not connected (status=%d)"), static_cast<int32>(ConnectionStatus));
-		return false;
+		if (Session.Zone.Get() == Zone)
+		{
+			return;
+		}
 	}
 
-	// Check socket connection state
-	ESocketConnectionState SocketState = SenderSocket->GetConnectionState();
-	if (SocketState != ESocketConnectionState::SCS_Connected)
+	FAefZoneSyncSession& NewSession = ZoneSyncSessions.AddDefaulted_GetRef();
+	NewSession.Zone = Zone;
+}
+
+void UAefDeepSyncSubsystem::EndZoneSession(AAefPharusDeepSyncZoneActor* Zone)
+{
+	if (!Zone) return;
+
+	for (int32 i = 0; i < ZoneSyncSessions.Num(); ++i)
 	{
-		UE_LOG(LogAefDeepSync, Warning, TEXT("Cannot send - SenderSocket not connected (state=%d)"), static_cast<int32>(SocketState));
-		return false;
+		if (ZoneSyncSessions[i].Zone.Get() == Zone)
+		{
+			// Zone callbacks may end sessions while we iterate - compact after the loop instead
+			if (bIsTickingZoneSyncs)
+			{
+				ZoneSyncSessions[i].Zone.Reset();
+			}
+			else
+			{
+				ZoneSyncSessions.RemoveAtSwap(i);
+			}
+			return;
+		}
 	}
+}
+
+void UAefDeepSyncSubsystem::TickZoneSyncSessions(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_ZoneSync);
+	CSV_SCOPED_TIMING_STAT(AefDeepSync, ZoneSync);
 
-	// JSON format with "type" field for polymorphic deserialization on server
-	FString JsonCommand = FString::Printf(TEXT("{\"type\":\"id\",\"Id\":%d,\"NewId\":%d}X"),
-		WearableId, NewId);
+	if (ZoneSyncSessions.Num() == 0) return;
 
-	FTCHARToUTF8 Converter(*JsonCommand);
-	int32 BytesSent = 0;
+	if (UsesGlobalZoneAssignment())
+	{
+		SolveZoneAssignment();
+	}
 
-	UE_LOG(LogAefDeepSync, Verbose, TEXT("Sending: %s (%d bytes)"), *JsonCommand, Converter.Length());
+	bIsTickingZoneSyncs = true;
 
-	if (!SenderSocket->Send((const uint8*)Converter.Get(), Converter.Length(), BytesSent))
+	// Sessions started by callbacks during this loop are appended and advance next frame
+	const int32 NumSessions = ZoneSyncSessions.Num();
+	for (int32 i = 0; i < NumSessions; ++i)
 	{
-		// Get socket error for diagnostics
-		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-		ESocketErrors LastError = SocketSubsystem ? SocketSubsystem->GetLastErrorCode() : SE_NO_ERROR;
-		FString ErrorString = SocketSubsystem ? SocketSubsystem->GetSocketError(LastError) : TEXT("Unknown");
-		
-		UE_LOG(LogAefDeepSync, Warning, TEXT("Send failed - Socket error: %s (code=%d, BytesSent=%d)"), 
-			*ErrorString, static_cast<int32>(LastError), BytesSent);
-		return false;
+		AAefPharusDeepSyncZoneActor* Zone = ZoneSyncSessions[i].Zone.Get();
+		if (!Zone) continue;
+
+		// Accumulate presence of every track in the zone, free zones pick the next candidate
+		Zone->AdvanceSyncCandidates(DeltaTime);
+		if (!Zone->bIsSyncing) continue;
+
+		if (!ActiveWearables.Contains(Zone->WearableId))
+		{
+			Zone->HandleSyncWearableLost();
+			continue;
+		}
+
+		Zone->UpdateSyncProgress();
 	}
 
-	if (Config.bLogIdCommands) UE_LOG(LogAefDeepSync, Log, TEXT("ID cmd: Wearable %d -> NewId %d (%d bytes sent)"), WearableId, NewId, BytesSent);
-	return true;
+	bIsTickingZoneSyncs = false;
+
+	ZoneSyncSessions.RemoveAllSwap([](const FAefZoneSyncSession& Session)
+	{
+		return !Session.Zone.IsValid();
+	});
 }
 
 //--------------------------------------------------------------------------------
-// Configuration
+// Global Zone Assignment
 //--------------------------------------------------------------------------------
 
-void UAefDeepSyncSubsystem::LoadConfiguration()
+void UAefDeepSyncSubsystem::SolveZoneAssignment()
 {
-	FString ConfigPath = FPaths::ProjectConfigDir() / TEXT("AefConfig.ini");
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_ZoneAssignment);
 
-	if (!FPaths::FileExists(ConfigPath))
+	AssignmentZones.Reset();
+	AssignmentTrackIDs.Reset();
+	AssignmentTrackColumns.Reset();
+	AssignmentSyncingTrackIDs.Reset();
+
+	// Running syncs and links are kept as they are, only free zones and tracks take part
+	for (const FAefZoneSyncSession& Session : ZoneSyncSessions)
 	{
-		UE_LOG(LogAefDeepSync, Warning, TEXT("AefConfig.ini not found - using defaults"));
-		return;
+		AAefPharusDeepSyncZoneActor* Zone = Session.Zone.Get();
+		if (!Zone) continue;
+
+		Zone->AssignedTrackID = -1;
+		if (Zone->bIsSyncing)
+		{
+			AssignmentSyncingTrackIDs.Add(Zone->CurrentPharusTrackID);
+		}
+		else if (Zone->bIsActive && Zone->SyncCandidates.Num() > 0 && IsWearableActive(Zone->WearableId) &&
+			!IsZoneBlocked(Zone) && !IsWearableBlocked(Zone->WearableId))
+		{
+			AssignmentZones.Add(Zone);
+		}
 	}
 
-	FConfigFile ConfigFile;
-	ConfigFile.Read(ConfigPath);
-	const TCHAR* Section = TEXT("DeepSync");
+	// Columns: every free track that stands in at least one free zone
+	for (const AAefPharusDeepSyncZoneActor* Zone : AssignmentZones)
+	{
+		for (const FAefZoneSyncCandidate& Candidate : Zone->SyncCandidates)
+		{
+			if (!AssignmentTrackColumns.Contains(Candidate.TrackID) &&
+				!AssignmentSyncingTrackIDs.Contains(Candidate.TrackID) &&
+				!IsPharusTrackBlocked(Candidate.TrackID))
+			{
+				AssignmentTrackColumns.Add(Candidate.TrackID, AssignmentTrackIDs.Num());
+				AssignmentTrackIDs.Add(Candidate.TrackID);
+			}
+		}
+	}
 
-	auto GetBool = [&](const TCHAR* Key, bool& OutValue) {
-		FString Value;
-		if (ConfigFile.GetString(Section, Key, Value))
-			OutValue = Value.Equals(TEXT("true"), ESearchCase::IgnoreCase);
-	};
+	const int32 NumRows = AssignmentZones.Num();
+	const int32 NumCols = AssignmentTrackIDs.Num();
+	if (NumRows == 0 || NumCols == 0) return;
 
-	// Startup
-	GetBool(TEXT("autoStart"), Config.bAutoStart);
+	// Cost: normalized distance to zone center minus normalized dwell time (closer and longer = cheaper)
+	AssignmentCosts.Init(FAefZoneAssignmentSolver::ForbiddenCost, NumRows * NumCols);
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		const AAefPharusDeepSyncZoneActor* Zone = AssignmentZones[Row];
+		const FVector ZoneCenter = Zone->GetActorLocation();
+		const float InvRadius = 1.0f / FMath::Max(Zone->ZoneRadius, 1.0f);
+		const float InvDuration = 1.0f / FMath::Max(Zone->SyncDuration, KINDA_SMALL_NUMBER);
 
-	// Connection
-	ConfigFile.GetString(Section, TEXT("deepSyncIp"), Config.ServerIP);
-	ConfigFile.GetInt(Section, TEXT("deepSyncReceiverPort"), Config.ReceiverPort);
-	ConfigFile.GetInt(Section, TEXT("deepSyncSenderPort"), Config.SenderPort);
+		for (const FAefZoneSyncCandidate& Candidate : Zone->SyncCandidates)
+		{
+			const AActor* Actor = Candidate.PharusActor.Get();
+			const int32* Col = AssignmentTrackColumns.Find(Candidate.TrackID);
+			if (!Actor || !Col || Candidate.bSyncCancelled) continue;
 
-	// Wearables (no ID restrictions - any positive ID allowed)
-	FString WearableIdsStr;
-	if (ConfigFile.GetString(Section, TEXT("wearableIds"), WearableIdsStr))
+			const float Distance = FVector::Dist2D(Actor->GetActorLocation(), ZoneCenter);
+			AssignmentCosts[Row * NumCols + *Col] = Distance * InvRadius - Candidate.PresenceTime * InvDuration;
+		}
+	}
+
+	ZoneAssignmentSolver.Solve(AssignmentCosts, NumRows, NumCols, AssignmentResult);
+
+	for (int32 Row = 0; Row < NumRows; ++Row)
 	{
-		TArray<FString> IdStrings;
-		WearableIdsStr.ParseIntoArray(IdStrings, TEXT(","), true);
-		for (const FString& IdStr : IdStrings)
+		if (AssignmentResult[Row] != INDEX_NONE)
 		{
-			int32 Id = FCString::Atoi(*IdStr.TrimStartAndEnd());
-			if (Id >= 0) Config.AllowedWearableIds.Add(Id);
+			AssignmentZones[Row]->AssignedTrackID = AssignmentTrackIDs[AssignmentResult[Row]];
 		}
 	}
+}
 
-	ConfigFile.GetFloat(Section, TEXT("wearableLostTimeout"), Config.WearableLostTimeout);
+//--------------------------------------------------------------------------------
+// Pharus Track Registry
+//--------------------------------------------------------------------------------
 
-	// Reconnection
-	ConfigFile.GetFloat(Section, TEXT("reconnectDelay"), Config.ReconnectDelay);
-	ConfigFile.GetInt(Section, TEXT("maxReconnectAttempts"), Config.MaxReconnectAttempts);
+void UAefDeepSyncSubsystem::TrackPharusActors(UWorld* World)
+{
+	if (!World || PharusWorld.Get() == World) return;
 
-	// Logging
-	GetBool(TEXT("logWearableConnected"), Config.bLogWearableConnected);
-	GetBool(TEXT("logWearableLost"), Config.bLogWearableLost);
-	GetBool(TEXT("logWearableUpdated"), Config.bLogWearableUpdated);
-	GetBool(TEXT("logHeartRateChanges"), Config.bLogHeartRateChanges);
-	GetBool(TEXT("logColorCommands"), Config.bLogColorCommands);
-	GetBool(TEXT("logIdCommands"), Config.bLogIdCommands);
-	GetBool(TEXT("logConnectionStatus"), Config.bLogConnectionStatus);
-	GetBool(TEXT("logSyncEvents"), Config.bLogSyncEvents);
-	GetBool(TEXT("logNetworkErrors"), Config.bLogNetworkErrors);
+	StopTrackingPharusActors();
+	PharusWorld = World;
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateUObject(this, &UAefDeepSyncSubsystem::HandleActorSpawned));
+
+	// Pick up tracks that exist before the first zone registered
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AddPharusActor(*It);
+	}
 }
 
-void UAefDeepSyncSubsystem::ReloadConfiguration()
+void UAefDeepSyncSubsystem::StopTrackingPharusActors()
 {
-	LoadConfiguration();
-	if (Config.bLogConnectionStatus) UE_LOG(LogAefDeepSync, Log, TEXT("Configuration reloaded"));
+	if (UWorld* World = PharusWorld.Get())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	ActorSpawnedHandle.Reset();
+	PharusWorld.Reset();
+
+	for (const TWeakObjectPtr<AActor>& WeakActor : PharusActors)
+	{
+		if (AActor* Actor = WeakActor.Get())
+		{
+			Actor->OnEndPlay.RemoveDynamic(this, &UAefDeepSyncSubsystem::HandlePharusActorEndPlay);
+		}
+	}
+	PharusActors.Reset();
+	ZoneOccupancy.Reset();
+}
+
+void UAefDeepSyncSubsystem::AddPharusActor(AActor* Actor)
+{
+	if (!FAefPharusTrackAccessor::IsPharusActor(Actor)) return;
+	if (Actor->OnEndPlay.IsAlreadyBound(this, &UAefDeepSyncSubsystem::HandlePharusActorEndPlay)) return;
+
+	// TrackID may not be assigned yet at spawn time, it is read when needed
+	Actor->OnEndPlay.AddDynamic(this, &UAefDeepSyncSubsystem::HandlePharusActorEndPlay);
+	PharusActors.Add(Actor);
+}
+
+void UAefDeepSyncSubsystem::HandleActorSpawned(AActor* Actor)
+{
+	AddPharusActor(Actor);
+}
+
+void UAefDeepSyncSubsystem::HandlePharusActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	PharusActors.RemoveSwap(Actor);
+
+	// Drop the track from zones in the same frame (EndOverlap may come late or never)
+	TArray<AAefPharusDeepSyncZoneActor*, TInlineAllocator<8>> SessionZones;
+	for (const FAefZoneSyncSession& Session : ZoneSyncSessions)
+	{
+		if (AAefPharusDeepSyncZoneActor* Zone = Session.Zone.Get())
+		{
+			SessionZones.Add(Zone);
+		}
+	}
+	for (AAefPharusDeepSyncZoneActor* Zone : SessionZones)
+	{
+		Zone->HandlePharusActorRemoved(Actor);
+	}
+
+	// Links of this track wait for a TrackID handoff, or are lost
+	for (int32 i = SyncedLinks.Num() - 1; i >= 0; --i)
+	{
+		if (!SyncedLinks.IsValidIndex(i) || SyncedLinks[i].PharusActor.Get() != Actor) continue;
+
+		if (Config.TrackHandoffWindow > 0.0f)
+		{
+			FAefSyncedLink& Link = SyncedLinks[i];
+			Link.LastPharusPosition = Actor->GetActorLocation();
+			Link.PharusActor.Reset();
+
+			FAefTrackHandoff& Handoff = PendingHandoffs.AddDefaulted_GetRef();
+			Handoff.LinkId = Link.LinkId;
+			Handoff.OldTrackID = Link.PharusTrackID;
+			Handoff.LastPosition = Link.LastPharusPosition;
+			Handoff.LostWorldTime = PharusWorld.IsValid() ? PharusWorld->GetTimeSeconds() : 0.0;
+			Handoff.TimeRemaining = Config.TrackHandoffWindow;
+		}
+		else
+		{
+			BreakLinkInternal(i, TEXT("PharusActorDestroyed"), true);
+		}
+	}
+
+	// Lost links now need a new track (actor is still valid during EndPlay)
+	for (FAefLinkTombstone& Tombstone : LinkTombstones)
+	{
+		if (Tombstone.Link.PharusActor.Get() == Actor)
+		{
+			Tombstone.Link.LastPharusPosition = Actor->GetActorLocation();
+			Tombstone.Link.PharusActor.Reset();
+		}
+	}
 }
 
 //--------------------------------------------------------------------------------
-// Zone Management
+// Spatial Hash Zone Detection
 //--------------------------------------------------------------------------------
 
-void UAefDeepSyncSubsystem::RegisterZone(AAefPharusDeepSyncZoneActor* Zone)
+static FORCEINLINE uint64 MakeOccupancyKey(int32 ZoneIndex, int32 TrackID)
 {
-	if (!Zone) return;
+	return (static_cast<uint64>(static_cast<uint32>(ZoneIndex)) << 32) | static_cast<uint32>(TrackID);
+}
 
-	// Check if already registered
+static FORCEINLINE int32 GetOccupancyZoneIndex(uint64 Key)
+{
+	return static_cast<int32>(Key >> 32);
+}
+
+static FORCEINLINE int32 GetOccupancyTrackID(uint64 Key)
+{
+	return static_cast<int32>(Key & 0xFFFFFFFFull);
+}
+
+void UAefDeepSyncSubsystem::RebuildZoneHash()
+{
+	bZoneLayoutDirty = false;
+
+	TArray<TWeakObjectPtr<AAefPharusDeepSyncZoneActor>> OldZones = MoveTemp(HashedZones);
+	HashedZones.Reset();
+
+	TArray<FVector2D> Centers;
+	TArray<float> Radii;
+	TMap<AAefPharusDeepSyncZoneActor*, int32> NewZoneIndices;
 	for (const auto& WeakZone : RegisteredZones)
 	{
-		if (WeakZone.Get() == Zone)
+		if (AAefPharusDeepSyncZoneActor* Zone = WeakZone.Get())
 		{
-			UE_LOG(LogAefDeepSync, Warning, TEXT("Zone already registered: WearableId=%d"), Zone->WearableId);
-			return;
+			const FVector Location = Zone->GetActorLocation();
+			NewZoneIndices.Add(Zone, HashedZones.Num());
+			HashedZones.Add(Zone);
+			Centers.Add(FVector2D(Location.X, Location.Y));
+			Radii.Add(Zone->TriggerSphere ? Zone->TriggerSphere->GetScaledSphereRadius() : Zone->ZoneRadius);
 		}
 	}
+	ZoneHash.Build(Centers, Radii, Config.ZoneHashCellSize);
 
-	RegisteredZones.Add(Zone);
-	UE_LOG(LogAefDeepSync, Log, TEXT("Zone registered: WearableId=%d (Total: %d)"), Zone->WearableId, RegisteredZones.Num());
-	OnZoneRegistered.Broadcast(Zone);
+	// Carry occupancy over to the new zone indices (removed zones drop out)
+	TArray<uint64> OldOccupancy = MoveTemp(ZoneOccupancy);
+	ZoneOccupancy.Reset();
+	for (uint64 Key : OldOccupancy)
+	{
+		const int32 OldIndex = GetOccupancyZoneIndex(Key);
+		AAefPharusDeepSyncZoneActor* Zone = OldZones.IsValidIndex(OldIndex) ? OldZones[OldIndex].Get() : nullptr;
+		if (const int32* NewIndex = Zone ? NewZoneIndices.Find(Zone) : nullptr)
+		{
+			ZoneOccupancy.Add(MakeOccupancyKey(*NewIndex, GetOccupancyTrackID(Key)));
+		}
+	}
+	ZoneOccupancy.Sort();
 }
 
-void UAefDeepSyncSubsystem::UnregisterZone(AAefPharusDeepSyncZoneActor* Zone)
+void UAefDeepSyncSubsystem::UpdateZoneOccupancy()
 {
-	if (!Zone) return;
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_ZoneDetection);
 
-	int32 RemoveIndex = -1;
-	for (int32 i = 0; i < RegisteredZones.Num(); ++i)
+	if (bZoneLayoutDirty)
 	{
-		if (RegisteredZones[i].Get() == Zone)
+		RebuildZoneHash();
+	}
+
+	// One hash lookup per track, independent of the number of zones
+	OccupancyScratch.Reset();
+	for (int32 i = PharusActors.Num() - 1; i >= 0; --i)
+	{
+		AActor* Actor = PharusActors[i].Get();
+		if (!Actor)
+		{
+			PharusActors.RemoveAtSwap(i);
+			continue;
+		}
+
+		int32 TrackID = -1;
+		if (!FAefPharusTrackAccessor::GetTrackID(Actor, TrackID))
 		{
-			RemoveIndex = i;
-			break;
+			continue;
 		}
-	}
 
-	if (RemoveIndex >= 0)
+		const FVector Location = Actor->GetActorLocation();
+		ZoneHash.ForEachZoneAt(FVector2D(Location.X, Location.Y), [this, Actor, TrackID](int32 ZoneIndex)
+		{
+			OccupancyScratch.Add({ MakeOccupancyKey(ZoneIndex, TrackID), Actor });
+		});
+	}
+	OccupancyScratch.Sort([](const FAefZoneOccupant& A, const FAefZoneOccupant& B) { return A.Key < B.Key; });
+
+	// Diff against last tick (both sorted) to get enter/leave transitions
+	TArray<FAefZoneOccupant, TInlineAllocator<16>> Entered;
+	TArray<uint64, TInlineAllocator<16>> Left;
+	int32 PrevIndex = 0;
+	int32 CurrIndex = 0;
+	while (PrevIndex < ZoneOccupancy.Num() || CurrIndex < OccupancyScratch.Num())
 	{
-		// Break any links using this zone
-		for (int32 i = SyncedLinks.Num() - 1; i >= 0; --i)
+		if (CurrIndex >= OccupancyScratch.Num() ||
+			(PrevIndex < ZoneOccupancy.Num() && ZoneOccupancy[PrevIndex] < OccupancyScratch[CurrIndex].Key))
 		{
-			if (SyncedLinks[i].Zone.Get() == Zone)
-			{
-				BreakLinkInternal(i, TEXT("ZoneUnregistered"));
-			}
+			Left.Add(ZoneOccupancy[PrevIndex++]);
 		}
+		else if (PrevIndex >= ZoneOccupancy.Num() || OccupancyScratch[CurrIndex].Key < ZoneOccupancy[PrevIndex])
+		{
+			Entered.Add(OccupancyScratch[CurrIndex++]);
+		}
+		else
+		{
+			++PrevIndex;
+			++CurrIndex;
+		}
+	}
 
-		RegisteredZones.RemoveAt(RemoveIndex);
-		UE_LOG(LogAefDeepSync, Log, TEXT("Zone unregistered: WearableId=%d (Remaining: %d)"), Zone->WearableId, RegisteredZones.Num());
-		OnZoneUnregistered.Broadcast(Zone);
+	ZoneOccupancy.Reset(OccupancyScratch.Num());
+	for (const FAefZoneOccupant& Occupant : OccupancyScratch)
+	{
+		ZoneOccupancy.Add(Occupant.Key);
 	}
-}
+	OccupancyScratch.Reset();
 
-TArray<AAefPharusDeepSyncZoneActor*> UAefDeepSyncSubsystem::GetAllZones() const
-{
-	TArray<AAefPharusDeepSyncZoneActor*> Result;
-	for (const auto& WeakZone : RegisteredZones)
+	// Dispatch once state is consistent, zone handlers may start or end syncs
+	for (uint64 Key : Left)
 	{
-		if (AAefPharusDeepSyncZoneActor* Zone = WeakZone.Get())
+		if (AAefPharusDeepSyncZoneActor* Zone = HashedZones[GetOccupancyZoneIndex(Key)].Get())
 		{
-			Result.Add(Zone);
+			Zone->NotifyPharusTrackLeft(GetOccupancyTrackID(Key));
 		}
 	}
-	return Result;
-}
-
-AAefPharusDeepSyncZoneActor* UAefDeepSyncSubsystem::GetZoneByWearableId(int32 InWearableId) const
-{
-	for (const auto& WeakZone : RegisteredZones)
+	for (const FAefZoneOccupant& Occupant : Entered)
 	{
-		if (AAefPharusDeepSyncZoneActor* Zone = WeakZone.Get())
+		AAefPharusDeepSyncZoneActor* Zone = HashedZones[GetOccupancyZoneIndex(Occupant.Key)].Get();
+		if (Zone && IsValid(Occupant.Actor))
 		{
-			if (Zone->WearableId == InWearableId)
-			{
-				return Zone;
-			}
+			Zone->NotifyPharusActorEntered(Occupant.Actor);
 		}
 	}
-	return nullptr;
 }
 
 //--------------------------------------------------------------------------------
@@ -773,9 +2901,13 @@ void UAefDeepSyncSubsystem::NotifySyncCompleted(const FAefPharusSyncResult& Resu
 	NewLink.ZoneColor = Result.ZoneColor;
 	NewLink.SyncTime = FDateTime::Now();
 
+	NewLink.LastPharusPosition = Result.PharusPosition;
+
 	SyncedLinks.Add(NewLink);
+	JournalLink(NewLink);
 	
 	if (Config.bLogSyncEvents) UE_LOG(LogAefDeepSync, Log, TEXT("Link established: %s"), *NewLink.ToString());
+	TRACE_AEFDEEPSYNC(OutputLinkEvent(TEXT("Established"), NewLink.LinkId, NewLink.PharusTrackID, NewLink.WearableId));
 	OnLinkEstablished.Broadcast(NewLink);
 }
 
@@ -832,6 +2964,15 @@ bool UAefDeepSyncSubsystem::IsZoneBlocked(AAefPharusDeepSyncZoneActor* Zone) con
 			return true;
 		}
 	}
+
+	// A lost link keeps its zone reserved while it may still be restored
+	for (const FAefLinkTombstone& Tombstone : LinkTombstones)
+	{
+		if (Tombstone.Link.Zone.Get() == Zone)
+		{
+			return true;
+		}
+	}
 	return false;
 }
 
@@ -856,6 +2997,14 @@ bool UAefDeepSyncSubsystem::IsWearableBlocked(int32 InWearableId) const
 			return true;
 		}
 	}
+
+	for (const FAefLinkTombstone& Tombstone : LinkTombstones)
+	{
+		if (Tombstone.Link.WearableId == InWearableId)
+		{
+			return true;
+		}
+	}
 	return false;
 }
 
@@ -873,6 +3022,14 @@ bool UAefDeepSyncSubsystem::DisconnectLink(int32 InWearableId)
 			return true;
 		}
 	}
+	for (int32 i = 0; i < LinkTombstones.Num(); ++i)
+	{
+		if (LinkTombstones[i].Link.WearableId == InWearableId)
+		{
+			ExpireLinkTombstone(i, TEXT("ManualDisconnect"));
+			return true;
+		}
+	}
 	return false;
 }
 
@@ -882,6 +3039,10 @@ void UAefDeepSyncSubsystem::DisconnectAllLinks()
 	{
 		BreakLinkInternal(SyncedLinks.Num() - 1, TEXT("DisconnectAll"));
 	}
+	while (LinkTombstones.Num() > 0)
+	{
+		ExpireLinkTombstone(LinkTombstones.Num() - 1, TEXT("DisconnectAll"));
+	}
 }
 
 //--------------------------------------------------------------------------------
@@ -890,21 +3051,27 @@ void UAefDeepSyncSubsystem::DisconnectAllLinks()
 
 void UAefDeepSyncSubsystem::CheckForBrokenLinks()
 {
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_LinkMaintenance);
+
 	for (int32 i = SyncedLinks.Num() - 1; i >= 0; --i)
 	{
-		const FAefSyncedLink& Link = SyncedLinks[i];
+		FAefSyncedLink& Link = SyncedLinks[i];
 
-		// Check if Pharus actor still exists
-		if (!Link.PharusActor.IsValid())
+		// Check if Pharus actor still exists (links waiting for a TrackID handoff stay)
+		if (const AActor* PharusActor = Link.PharusActor.Get())
+		{
+			Link.LastPharusPosition = PharusActor->GetActorLocation();
+		}
+		else if (!IsHandoffPending(Link.LinkId))
 		{
-			BreakLinkInternal(i, TEXT("PharusActorDestroyed"));
+			BreakLinkInternal(i, TEXT("PharusActorDestroyed"), true);
 			continue;
 		}
 
 		// Check if wearable is still active
 		if (!IsWearableActive(Link.WearableId))
 		{
-			BreakLinkInternal(i, TEXT("WearableLost"));
+			BreakLinkInternal(i, TEXT("WearableLost"), true);
 			continue;
 		}
 
@@ -917,14 +3084,478 @@ void UAefDeepSyncSubsystem::CheckForBrokenLinks()
 	}
 }
 
-void UAefDeepSyncSubsystem::BreakLinkInternal(int32 Index, const FString& Reason)
+void UAefDeepSyncSubsystem::BreakLinkInternal(int32 Index, const FString& Reason, bool bAllowRelink)
 {
 	if (Index < 0 || Index >= SyncedLinks.Num()) return;
 
 	FAefSyncedLink BrokenLink = SyncedLinks[Index];
 	SyncedLinks.RemoveAt(Index);
 
+	if (const AActor* PharusActor = BrokenLink.PharusActor.Get())
+	{
+		BrokenLink.LastPharusPosition = PharusActor->GetActorLocation();
+	}
+
+	// Park the link instead of breaking it, OnLinkBroken fires only if the grace window runs out
+	if (bAllowRelink && Config.LinkGraceWindow > 0.0f && BrokenLink.Zone.IsValid())
+	{
+		FAefLinkTombstone& Tombstone = LinkTombstones.AddDefaulted_GetRef();
+		Tombstone.Link = BrokenLink;
+		Tombstone.Reason = Reason;
+		Tombstone.TimeRemaining = Config.LinkGraceWindow;
+		Tombstone.LostWorldTime = PharusWorld.IsValid() ? PharusWorld->GetTimeSeconds() : 0.0;
+
+		if (Config.bLogSyncEvents) UE_LOG(LogAefDeepSync, Log, TEXT("Link lost: %s (Reason: %s), waiting %.1fs for relink"),
+			*BrokenLink.ToString(), *Reason, Config.LinkGraceWindow);
+		return;
+	}
+
+	JournalLinkBroken(BrokenLink);
+
+	if (Config.bLogSyncEvents) UE_LOG(LogAefDeepSync, Log, TEXT("Link broken: %s (Reason: %s)"), *BrokenLink.ToString(), *Reason);
+	TRACE_AEFDEEPSYNC(OutputLinkEvent(TEXT("Broken"), BrokenLink.LinkId, BrokenLink.PharusTrackID, BrokenLink.WearableId));
+	OnLinkBroken.Broadcast(BrokenLink, Reason);
+}
+
+//--------------------------------------------------------------------------------
+// Link Tombstones
+//--------------------------------------------------------------------------------
+
+void UAefDeepSyncSubsystem::UpdateLinkTombstones(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_LinkMaintenance);
+
+	for (int32 i = LinkTombstones.Num() - 1; i >= 0; --i)
+	{
+		if (!LinkTombstones.IsValidIndex(i)) continue;
+
+		FAefLinkTombstone& Tombstone = LinkTombstones[i];
+		if (!Tombstone.Link.Zone.IsValid())
+		{
+			ExpireLinkTombstone(i, TEXT("ZoneDestroyed"));
+			continue;
+		}
+
+		// Restore once the wearable is back and a track is there (the old one or a new one nearby)
+		AActor* PharusActor = Tombstone.Link.PharusActor.Get();
+		if (PharusActor)
+		{
+			// The visitor synced somewhere else in the meantime
+			if (IsPharusTrackBlocked(Tombstone.Link.PharusTrackID))
+			{
+				ExpireLinkTombstone(i, Tombstone.Reason);
+				continue;
+			}
+			Tombstone.Link.LastPharusPosition = PharusActor->GetActorLocation();
+		}
+		if (IsWearableActive(Tombstone.Link.WearableId))
+		{
+			if (!PharusActor)
+			{
+				PharusActor = FindRelinkPharusActor(Tombstone);
+			}
+			if (PharusActor)
+			{
+				RestoreLink(i, PharusActor);
+				continue;
+			}
+		}
+
+		Tombstone.TimeRemaining -= DeltaTime;
+		if (Tombstone.TimeRemaining <= 0.0f)
+		{
+			ExpireLinkTombstone(i, Tombstone.Reason);
+		}
+	}
+}
+
+AActor* UAefDeepSyncSubsystem::FindRelinkPharusActor(const FAefLinkTombstone& Tombstone) const
+{
+	const double MaxDistSq = FMath::Square(static_cast<double>(Config.LinkRelinkRadius));
+
+	AActor* BestActor = nullptr;
+	double BestDistSq = MaxDistSq;
+	for (const TWeakObjectPtr<AActor>& WeakActor : PharusActors)
+	{
+		AActor* Actor = WeakActor.Get();
+		if (!Actor) continue;
+
+		const double DistSq = FVector::DistSquared2D(Actor->GetActorLocation(), Tombstone.Link.LastPharusPosition);
+		if (DistSq > BestDistSq || !IsNewPharusActor(Actor, Tombstone.LostWorldTime)) continue;
+
+		int32 TrackID = -1;
+		if (!FAefPharusTrackAccessor::GetTrackID(Actor, TrackID) || IsPharusTrackBlocked(TrackID) || IsPharusTrackSyncing(TrackID)) continue;
+
+		BestActor = Actor;
+		BestDistSq = DistSq;
+	}
+	return BestActor;
+}
+
+bool UAefDeepSyncSubsystem::IsNewPharusActor(const AActor* Actor, double LostWorldTime) const
+{
+	// Only tracks that appeared around or after the loss, so a bystander is not picked up.
+	// The tracker may create the new track slightly before it removes the old one.
+	constexpr double SpawnTolerance = 1.0;
+	const UWorld* World = Actor->GetWorld();
+	return !World || World->GetTimeSeconds() - Actor->GetGameTimeSinceCreation() >= LostWorldTime - SpawnTolerance;
+}
+
+bool UAefDeepSyncSubsystem::IsPharusTrackSyncing(int32 TrackID) const
+{
+	// A track syncing in a zone would be linked a second time when that sync completes
+	for (const FAefZoneSyncSession& Session : ZoneSyncSessions)
+	{
+		const AAefPharusDeepSyncZoneActor* Zone = Session.Zone.Get();
+		if (Zone && Zone->bIsSyncing && Zone->CurrentPharusTrackID == TrackID)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void UAefDeepSyncSubsystem::RestoreLink(int32 TombstoneIndex, AActor* PharusActor)
+{
+	FAefSyncedLink RestoredLink = LinkTombstones[TombstoneIndex].Link;
+	LinkTombstones.RemoveAt(TombstoneIndex);
+
+	if (RestoredLink.PharusActor.Get() != PharusActor)
+	{
+		FAefPharusTrackAccessor::GetTrackID(PharusActor, RestoredLink.PharusTrackID);
+		RestoredLink.PharusActor = PharusActor;
+		AddPharusActor(PharusActor);
+	}
+	RestoredLink.LastPharusPosition = PharusActor->GetActorLocation();
+
+	SyncedLinks.Add(RestoredLink);
+	JournalLink(RestoredLink);
+
+	if (Config.bLogSyncEvents) UE_LOG(LogAefDeepSync, Log, TEXT("Link restored: %s"), *RestoredLink.ToString());
+	TRACE_AEFDEEPSYNC(OutputLinkEvent(TEXT("Restored"), RestoredLink.LinkId, RestoredLink.PharusTrackID, RestoredLink.WearableId));
+	OnLinkRestored.Broadcast(RestoredLink);
+}
+
+void UAefDeepSyncSubsystem::ExpireLinkTombstone(int32 TombstoneIndex, const FString& Reason)
+{
+	if (!LinkTombstones.IsValidIndex(TombstoneIndex)) return;
+
+	FAefSyncedLink BrokenLink = LinkTombstones[TombstoneIndex].Link;
+	LinkTombstones.RemoveAt(TombstoneIndex);
+
+	JournalLinkBroken(BrokenLink);
+
 	if (Config.bLogSyncEvents) UE_LOG(LogAefDeepSync, Log, TEXT("Link broken: %s (Reason: %s)"), *BrokenLink.ToString(), *Reason);
+	TRACE_AEFDEEPSYNC(OutputLinkEvent(TEXT("Broken"), BrokenLink.LinkId, BrokenLink.PharusTrackID, BrokenLink.WearableId));
 	OnLinkBroken.Broadcast(BrokenLink, Reason);
 }
 
+
+//--------------------------------------------------------------------------------
+// Track Handoff
+//--------------------------------------------------------------------------------
+
+void UAefDeepSyncSubsystem::UpdateTrackHandoffs(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_LinkMaintenance);
+
+	if (PendingHandoffs.Num() == 0) return;
+
+	// Drop handoffs whose link was broken meanwhile (manual disconnect, wearable lost, ...)
+	PendingHandoffs.RemoveAllSwap([this](const FAefTrackHandoff& Handoff)
+	{
+		return FindLinkIndex(Handoff.LinkId) == INDEX_NONE;
+	});
+	if (PendingHandoffs.Num() == 0) return;
+
+	// Grid over the vanished positions, each new track looks up only nearby handoffs
+	HandoffCenters.Reset();
+	HandoffRadii.Reset();
+	for (const FAefTrackHandoff& Handoff : PendingHandoffs)
+	{
+		HandoffCenters.Add(FVector2D(Handoff.LastPosition));
+		HandoffRadii.Add(Config.TrackHandoffRadius);
+	}
+	HandoffHash.Build(HandoffCenters, HandoffRadii);
+
+	HandoffMatches.Reset();
+	for (const TWeakObjectPtr<AActor>& WeakActor : PharusActors)
+	{
+		AActor* Actor = WeakActor.Get();
+		if (!Actor) continue;
+
+		const FVector2D Position(Actor->GetActorLocation());
+		int32 TrackID = -1;
+		HandoffHash.ForEachZoneAt(Position, [&](int32 HandoffIndex)
+		{
+			const FAefTrackHandoff& Handoff = PendingHandoffs[HandoffIndex];
+			if (!IsNewPharusActor(Actor, Handoff.LostWorldTime)) return;
+			if (TrackID < 0 && !FAefPharusTrackAccessor::GetTrackID(Actor, TrackID)) return;
+
+			FAefHandoffMatch& Match = HandoffMatches.AddDefaulted_GetRef();
+			Match.DistSq = FVector2D::DistSquared(Position, HandoffCenters[HandoffIndex]);
+			Match.HandoffIndex = HandoffIndex;
+			Match.Actor = Actor;
+			Match.TrackID = TrackID;
+		});
+	}
+
+	// Closest pairs first, every handoff and every new track is used once
+	HandoffMatches.Sort([](const FAefHandoffMatch& A, const FAefHandoffMatch& B) { return A.DistSq < B.DistSq; });
+	TArray<TPair<FAefSyncedLink, int32>, TInlineAllocator<4>> Reassigned;
+	for (const FAefHandoffMatch& Match : HandoffMatches)
+	{
+		FAefTrackHandoff& Handoff = PendingHandoffs[Match.HandoffIndex];
+		if (Handoff.LinkId < 0) continue;
+		if (IsPharusTrackBlocked(Match.TrackID) || IsPharusTrackSyncing(Match.TrackID)) continue;
+
+		const int32 LinkIndex = FindLinkIndex(Handoff.LinkId);
+		if (LinkIndex == INDEX_NONE) continue;
+
+		FAefSyncedLink& Link = SyncedLinks[LinkIndex];
+		Link.PharusTrackID = Match.TrackID;
+		Link.PharusActor = Match.Actor;
+		Link.LastPharusPosition = Match.Actor->GetActorLocation();
+		AddPharusActor(Match.Actor);
+
+		const int32 OldTrackID = Handoff.OldTrackID;
+		Handoff.LinkId = -1;
+
+		if (Config.bLogSyncEvents) UE_LOG(LogAefDeepSync, Log, TEXT("Link track reassigned: %s (was Track=%d)"), *Link.ToString(), OldTrackID);
+		JournalLink(Link);
+		TRACE_AEFDEEPSYNC(OutputLinkEvent(TEXT("Reassigned"), Link.LinkId, Link.PharusTrackID, Link.WearableId));
+		Reassigned.Emplace(Link, OldTrackID);
+	}
+
+	// Unmatched handoffs run out and become a lost link (tombstone if linkGraceWindow > 0)
+	TArray<int32, TInlineAllocator<4>> ExpiredLinkIds;
+	for (int32 i = PendingHandoffs.Num() - 1; i >= 0; --i)
+	{
+		FAefTrackHandoff& Handoff = PendingHandoffs[i];
+		if (Handoff.LinkId >= 0)
+		{
+			Handoff.TimeRemaining -= DeltaTime;
+			if (Handoff.TimeRemaining > 0.0f) continue;
+
+			ExpiredLinkIds.Add(Handoff.LinkId);
+		}
+		PendingHandoffs.RemoveAtSwap(i);
+	}
+
+	// Broadcast last, handlers may disconnect links or stop DeepSync
+	for (const TPair<FAefSyncedLink, int32>& Entry : Reassigned)
+	{
+		OnLinkTrackReassigned.Broadcast(Entry.Key, Entry.Value);
+	}
+	for (int32 LinkId : ExpiredLinkIds)
+	{
+		const int32 LinkIndex = FindLinkIndex(LinkId);
+		if (LinkIndex != INDEX_NONE)
+		{
+			BreakLinkInternal(LinkIndex, TEXT("PharusActorDestroyed"), true);
+		}
+	}
+}
+
+bool UAefDeepSyncSubsystem::IsHandoffPending(int32 LinkId) const
+{
+	return PendingHandoffs.ContainsByPredicate([LinkId](const FAefTrackHandoff& Handoff)
+	{
+		return Handoff.LinkId == LinkId;
+	});
+}
+
+int32 UAefDeepSyncSubsystem::FindLinkIndex(int32 LinkId) const
+{
+	return SyncedLinks.IndexOfByPredicate([LinkId](const FAefSyncedLink& Link)
+	{
+		return Link.LinkId == LinkId;
+	});
+}
+
+//--------------------------------------------------------------------------------
+// Warm-Start Journal
+//--------------------------------------------------------------------------------
+
+void UAefDeepSyncSubsystem::OpenJournal()
+{
+	const FString JournalPath = Config.JournalFile.IsEmpty()
+		? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AefDeepSync"), TEXT("DeepSync.journal"))
+		: Config.JournalFile;
+
+	// Replay the previous run before the file is truncated
+	FAefJournalState State;
+	if (FAefDeepSyncJournal::Replay(JournalPath, State))
+	{
+		NextUniqueId = FMath::Max(NextUniqueId, State.NextUniqueId);
+		NextLinkId = FMath::Max(NextLinkId, State.NextLinkId);
+		JournalUniqueIds = MoveTemp(State.WearableUniqueIds);
+		State.Links.GenerateValueArray(JournalPendingLinks);
+		JournalRestoreDeadline = 0.0;
+
+		UE_LOG(LogAefDeepSync, Log, TEXT("Journal: %d links and %d wearables to restore within %.0fs of connecting"),
+			JournalPendingLinks.Num(), JournalUniqueIds.Num(), Config.JournalRestoreWindow);
+	}
+
+	if (Journal.Open(JournalPath))
+	{
+		// New journal starts with the replayed state, a second crash during the window keeps it
+		WriteJournalCheckpoint();
+	}
+}
+
+void UAefDeepSyncSubsystem::UpdateJournal(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_Journal);
+
+	if (JournalPendingLinks.Num() > 0 || JournalUniqueIds.Num() > 0)
+	{
+		RestoreJournalLinks();
+	}
+
+	if (!Journal.IsOpen()) return;
+
+	JournalSnapshotTimer += DeltaTime;
+	if (JournalSnapshotTimer < Config.JournalSnapshotInterval) return;
+	JournalSnapshotTimer = 0.0f;
+
+	if (Journal.GetBytesSinceCompaction() > JournalCompactionBytes)
+	{
+		Journal.BeginCompaction();
+		WriteJournalCheckpoint();
+	}
+	else
+	{
+		WriteJournalSnapshot();
+	}
+}
+
+void UAefDeepSyncSubsystem::RestoreJournalLinks()
+{
+	// Only runs while connected, the window starts with the first connect, not with startup
+	const double Now = FPlatformTime::Seconds();
+	if (JournalRestoreDeadline <= 0.0)
+	{
+		JournalRestoreDeadline = Now + Config.JournalRestoreWindow;
+	}
+
+	if (Now > JournalRestoreDeadline)
+	{
+		for (const FAefJournalLink& Pending : JournalPendingLinks)
+		{
+			Journal.WriteLinkBroken(Pending.LinkId);
+		}
+		if (JournalPendingLinks.Num() > 0 && Config.bLogSyncEvents)
+		{
+			UE_LOG(LogAefDeepSync, Log, TEXT("Journal: restore window over, %d links not restored"), JournalPendingLinks.Num());
+		}
+		JournalPendingLinks.Reset();
+		JournalUniqueIds.Reset();
+		return;
+	}
+
+	for (int32 i = JournalPendingLinks.Num() - 1; i >= 0; --i)
+	{
+		const FAefJournalLink& Pending = JournalPendingLinks[i];
+		if (!IsWearableActive(Pending.WearableId)) continue;
+
+		AAefPharusDeepSyncZoneActor* Zone = GetZoneByWearableId(Pending.ZoneWearableId);
+		if (!Zone) continue;
+
+		// The tracker runs independently of the game, so the visitor usually keeps the TrackID
+		AActor* PharusActor = nullptr;
+		for (const TWeakObjectPtr<AActor>& WeakActor : PharusActors)
+		{
+			int32 TrackID = -1;
+			AActor* Actor = WeakActor.Get();
+			if (Actor && FAefPharusTrackAccessor::GetTrackID(Actor, TrackID) && TrackID == Pending.PharusTrackID)
+			{
+				PharusActor = Actor;
+				break;
+			}
+		}
+		if (!PharusActor) continue;
+
+		if (IsZoneBlocked(Zone) || IsWearableBlocked(Pending.WearableId) || IsPharusTrackBlocked(Pending.PharusTrackID) ||
+			IsPharusTrackSyncing(Pending.PharusTrackID))
+		{
+			Journal.WriteLinkBroken(Pending.LinkId);
+			JournalPendingLinks.RemoveAtSwap(i);
+			continue;
+		}
+
+		FAefSyncedLink RestoredLink;
+		RestoredLink.LinkId = Pending.LinkId;
+		RestoredLink.Zone = Zone;
+		RestoredLink.PharusTrackID = Pending.PharusTrackID;
+		RestoredLink.WearableId = Pending.WearableId;
+		RestoredLink.PharusActor = PharusActor;
+		RestoredLink.ZoneColor = Pending.ZoneColor;
+		RestoredLink.SyncTime = FDateTime(Pending.SyncTimeTicks);
+		RestoredLink.LastPharusPosition = PharusActor->GetActorLocation();
+		JournalPendingLinks.RemoveAtSwap(i);
+
+		SyncedLinks.Add(RestoredLink);
+		JournalLink(RestoredLink);
+
+		if (Config.bLogSyncEvents) UE_LOG(LogAefDeepSync, Log, TEXT("Link restored from journal: %s"), *RestoredLink.ToString());
+		TRACE_AEFDEEPSYNC(OutputLinkEvent(TEXT("Restored"), RestoredLink.LinkId, RestoredLink.PharusTrackID, RestoredLink.WearableId));
+		OnLinkRestored.Broadcast(RestoredLink);
+	}
+}
+
+void UAefDeepSyncSubsystem::WriteJournalCheckpoint()
+{
+	WriteJournalSnapshot();
+
+	for (const FAefSyncedLink& Link : SyncedLinks)
+	{
+		JournalLink(Link);
+	}
+	for (const FAefLinkTombstone& Tombstone : LinkTombstones)
+	{
+		JournalLink(Tombstone.Link);
+	}
+	for (const FAefJournalLink& Pending : JournalPendingLinks)
+	{
+		Journal.WriteLink(Pending);
+	}
+}
+
+void UAefDeepSyncSubsystem::WriteJournalSnapshot()
+{
+	TMap<int32, int32> UniqueIds = JournalUniqueIds;
+	for (const auto& Pair : ActiveWearables)
+	{
+		UniqueIds.Add(Pair.Key, Pair.Value.UniqueId);
+	}
+	Journal.WriteSnapshot(NextUniqueId, NextLinkId, UniqueIds);
+}
+
+void UAefDeepSyncSubsystem::JournalLink(const FAefSyncedLink& Link)
+{
+	if (!Journal.IsOpen()) return;
+
+	const AAefPharusDeepSyncZoneActor* Zone = Link.Zone.Get();
+
+	FAefJournalLink Entry;
+	Entry.LinkId = Link.LinkId;
+	Entry.WearableId = Link.WearableId;
+	Entry.PharusTrackID = Link.PharusTrackID;
+	Entry.ZoneWearableId = Zone ? Zone->WearableId : Link.WearableId;
+	Entry.LastPharusPosition = FVector3f(Link.LastPharusPosition);
+	Entry.ZoneColor = Link.ZoneColor;
+	Entry.SyncTimeTicks = Link.SyncTime.GetTicks();
+	Journal.WriteLink(Entry);
+}
+
+void UAefDeepSyncSubsystem::JournalLinkBroken(const FAefSyncedLink& Link)
+{
+	if (!Journal.IsOpen()) return;
+
+	// Zones and tracks go away when the world shuts down, those links should survive the restart
+	const UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+	if (!World || World->bIsTearingDown) return;
+
+	Journal.WriteLinkBroken(Link.LinkId);
+}
@@ -0,0 +1,515 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Synthetic Server Implementation
+========================================================================*/
+
+#include "AefDeepSyncSyntheticServer.h"
+#include "AefDeepSyncTypes.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Parse.h"
+#include "Misc/StringBuilder.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Dom/JsonObject.h"
+
+#if !UE_BUILD_SHIPPING
+
+//--------------------------------------------------------------------------------
+// Settings
+//--------------------------------------------------------------------------------
+
+FAefSyntheticServerSettings FAefSyntheticServerSettings::Parse(const TCHAR* Params)
+{
+	FAefSyntheticServerSettings Settings;
+	FParse::Value(Params, TEXT("ReceiverPort="), Settings.ReceiverPort);
+	FParse::Value(Params, TEXT("SenderPort="), Settings.SenderPort);
+	FParse::Value(Params, TEXT("Wearables="), Settings.NumWearables);
+	FParse::Value(Params, TEXT("FirstId="), Settings.FirstWearableId);
+	FParse::Value(Params, TEXT("Rate="), Settings.UpdateRate);
+	FParse::Value(Params, TEXT("Jitter="), Settings.JitterMs);
+	FParse::Value(Params, TEXT("Dropouts="), Settings.DropoutsPerMinute);
+	FParse::Value(Params, TEXT("DropoutDuration="), Settings.DropoutDuration);
+	FParse::Value(Params, TEXT("Bursts="), Settings.BurstsPerMinute);
+	FParse::Value(Params, TEXT("BurstDuration="), Settings.BurstDuration);
+	FParse::Value(Params, TEXT("Seed="), Settings.Seed);
+
+	Settings.NumWearables = FMath::Max(Settings.NumWearables, 0);
+	Settings.UpdateRate = FMath::Clamp(Settings.UpdateRate, 0.1f, 1000.0f);
+	return Settings;
+}
+
+//--------------------------------------------------------------------------------
+// Lifecycle
+//--------------------------------------------------------------------------------
+
+FAefDeepSyncSyntheticServer::~FAefDeepSyncSyntheticServer()
+{
+	Shutdown();
+}
+
+bool FAefDeepSyncSyntheticServer::Start(const FAefSyntheticServerSettings& InSettings)
+{
+	Shutdown();
+	Settings = InSettings;
+	Random.Initialize(Settings.Seed);
+
+	DataListener = FTcpSocketBuilder(TEXT("AefSyntheticServerData"))
+		.AsReusable()
+		.AsNonBlocking()
+		.BoundToPort(Settings.ReceiverPort)
+		.Listening(16)
+		.Build();
+	CommandListener = FTcpSocketBuilder(TEXT("AefSyntheticServerCommands"))
+		.AsReusable()
+		.AsNonBlocking()
+		.BoundToPort(Settings.SenderPort)
+		.Listening(16)
+		.Build();
+
+	if (!DataListener || !CommandListener)
+	{
+		UE_LOG(LogAefDeepSync, Error, TEXT("Synthetic server: cannot listen on ports %d/%d"),
+			Settings.ReceiverPort, Settings.SenderPort);
+		Shutdown();
+		return false;
+	}
+
+	// Resting rates spread like a crowd, first updates staggered over one period
+	const double Period = 1.0 / Settings.UpdateRate;
+	Wearables.SetNum(Settings.NumWearables);
+	for (int32 i = 0; i < Wearables.Num(); ++i)
+	{
+		FSimWearable& Wearable = Wearables[i];
+		Wearable.WearableId = Settings.FirstWearableId + i;
+		Wearable.RestingHeartRate = Random.FRandRange(60.0f, 100.0f);
+		Wearable.HeartRate = Wearable.RestingHeartRate;
+		Wearable.NextSendTime = Random.FRand() * Period;
+	}
+
+	bStopping = false;
+	Thread = FRunnableThread::Create(this, TEXT("AefDeepSyncSyntheticServer"));
+	if (!Thread)
+	{
+		Shutdown();
+		return false;
+	}
+
+	UE_LOG(LogAefDeepSync, Log, TEXT("Synthetic server: %d wearables at %.0f Hz on ports %d/%d"),
+		Settings.NumWearables, Settings.UpdateRate, Settings.ReceiverPort, Settings.SenderPort);
+	return true;
+}
+
+void FAefDeepSyncSyntheticServer::Shutdown()
+{
+	if (Thread)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	for (FClient& Client : DataClients)
+	{
+		CloseClient(Client);
+	}
+	for (FClient& Client : CommandClients)
+	{
+		CloseClient(Client);
+	}
+	DataClients.Reset();
+	CommandClients.Reset();
+	ClientCount = 0;
+
+	for (FSocket** Listener : { &DataListener, &CommandListener })
+	{
+		if (*Listener)
+		{
+			(*Listener)->Close();
+			ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(*Listener);
+			*Listener = nullptr;
+		}
+	}
+}
+
+void FAefDeepSyncSyntheticServer::CloseClient(FClient& Client)
+{
+	if (Client.Socket)
+	{
+		Client.Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Client.Socket);
+		Client.Socket = nullptr;
+	}
+}
+
+//--------------------------------------------------------------------------------
+// Server Thread
+//--------------------------------------------------------------------------------
+
+uint32 FAefDeepSyncSyntheticServer::Run()
+{
+	StartTime = FPlatformTime::Seconds();
+	double LastTime = 0.0;
+
+	while (!bStopping)
+	{
+		const double Now = FPlatformTime::Seconds() - StartTime;
+
+		AcceptClients(DataListener, DataClients, TEXT("AefSyntheticServerDataClient"));
+		AcceptClients(CommandListener, CommandClients, TEXT("AefSyntheticServerCommandClient"));
+		ClientCount = DataClients.Num() + CommandClients.Num();
+
+		PendingFrames += GenerateFrames(Now);
+
+		// Burst: hold the stream back, the backlog then arrives in one go
+		if (Settings.BurstsPerMinute > 0.0f && Now >= BurstUntil &&
+			Random.FRand() < Settings.BurstsPerMinute / 60.0 * (Now - LastTime))
+		{
+			BurstUntil = Now + Settings.BurstDuration;
+		}
+		if (Now >= BurstUntil)
+		{
+			SendFrames();
+		}
+
+		ReceiveCommands();
+
+		LastTime = Now;
+		FPlatformProcess::Sleep(0.001f);
+	}
+	return 0;
+}
+
+void FAefDeepSyncSyntheticServer::AcceptClients(FSocket* Listener, TArray<FClient>& Clients, const TCHAR* Name)
+{
+	bool bHasPendingConnection = false;
+	while (Listener->HasPendingConnection(bHasPendingConnection) && bHasPendingConnection)
+	{
+		FSocket* Socket = Listener->Accept(Name);
+		if (!Socket)
+		{
+			break;
+		}
+
+		Socket->SetNonBlocking(true);
+		Socket->SetNoDelay(true);
+		Clients.AddDefaulted_GetRef().Socket = Socket;
+		UE_LOG(LogAefDeepSync, Log, TEXT("Synthetic server: %s connected"), Name);
+	}
+}
+
+int32 FAefDeepSyncSyntheticServer::GenerateFrames(double Now)
+{
+	const double Period = 1.0 / Settings.UpdateRate;
+	const double Jitter = Settings.JitterMs / 1000.0;
+	const double DropoutChance = Settings.DropoutsPerMinute / 60.0 * Period;
+	const int32 TimestampMs = static_cast<int32>(Now * 1000.0);
+
+	int32 NumFrames = 0;
+	TAnsiStringBuilder<128> Frame;
+	for (FSimWearable& Wearable : Wearables)
+	{
+		if (Now < Wearable.NextSendTime)
+		{
+			continue;
+		}
+
+		// Zero-mean jitter keeps the average rate, a stalled loop doesn't cause a catch-up flood
+		Wearable.NextSendTime += Period + Random.FRandRange(-0.5f, 0.5f) * Jitter;
+		if (Wearable.NextSendTime < Now)
+		{
+			Wearable.NextSendTime = Now + Period;
+		}
+
+		if (Now < Wearable.SilentUntil)
+		{
+			continue;
+		}
+		if (DropoutChance > 0.0 && Random.FRand() < DropoutChance)
+		{
+			Wearable.SilentUntil = Now + Settings.DropoutDuration;
+			continue;
+		}
+
+		// Random walk pulled back to the resting rate
+		Wearable.HeartRate += (Wearable.RestingHeartRate - Wearable.HeartRate) * 0.02f + Random.FRandRange(-1.0f, 1.0f);
+		Wearable.HeartRate = FMath::Clamp(Wearable.HeartRate, 40.0f, 200.0f);
+
+		if (Wearable.bHasEffect)
+		{
+			bool bFinished = false;
+			const FAefDeepSyncColor Color = Wearable.Effect.Step(Now, FMath::RoundToInt32(Wearable.HeartRate), bFinished);
+			Wearable.R = Color.R;
+			Wearable.G = Color.G;
+			Wearable.B = Color.B;
+			Wearable.bHasEffect = !bFinished;
+		}
+
+		Frame.Reset();
+		Frame.Appendf("{\"Id\":%d,\"HeartRate\":%d,\"Timestamp\":%d,\"Color\":{\"R\":%d,\"G\":%d,\"B\":%d}}X",
+			Wearable.WearableId, FMath::RoundToInt32(Wearable.HeartRate), TimestampMs,
+			Wearable.R, Wearable.G, Wearable.B);
+		FrameBuffer.Append(reinterpret_cast<const uint8*>(Frame.GetData()), Frame.Len());
+		++NumFrames;
+	}
+	return NumFrames;
+}
+
+void FAefDeepSyncSyntheticServer::SendFrames()
+{
+	if (FrameBuffer.Num() == 0)
+	{
+		return;
+	}
+
+	if (DataClients.Num() > 0)
+	{
+		FramesSent += PendingFrames;
+	}
+	PendingFrames = 0;
+
+	for (int32 i = DataClients.Num() - 1; i >= 0; --i)
+	{
+		FClient& Client = DataClients[i];
+
+		// Send straight from the frame buffer unless older data is still waiting
+		bool bBacklogged = Client.Buffer.Num() > 0;
+		if (bBacklogged)
+		{
+			Client.Buffer.Append(FrameBuffer);
+		}
+		const TArray<uint8>& Data = bBacklogged ? Client.Buffer : FrameBuffer;
+
+		int32 Sent = 0;
+		bool bOk = Client.Socket->Send(Data.GetData(), Data.Num(), Sent);
+		if (!bOk && ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() != SE_EWOULDBLOCK)
+		{
+			UE_LOG(LogAefDeepSync, Log, TEXT("Synthetic server: data client disconnected"));
+			CloseClient(Client);
+			DataClients.RemoveAtSwap(i);
+			continue;
+		}
+
+		Sent = FMath::Max(Sent, 0);
+		BytesSent += Sent;
+		if (bBacklogged)
+		{
+			Client.Buffer.RemoveAt(0, Sent, EAllowShrinking::No);
+		}
+		else if (Sent < FrameBuffer.Num())
+		{
+			Client.Buffer.Append(FrameBuffer.GetData() + Sent, FrameBuffer.Num() - Sent);
+		}
+
+		if (Client.Buffer.Num() > MaxClientBacklog)
+		{
+			UE_LOG(LogAefDeepSync, Warning, TEXT("Synthetic server: client fell %d bytes behind, dropping it"), Client.Buffer.Num());
+			CloseClient(Client);
+			DataClients.RemoveAtSwap(i);
+		}
+	}
+
+	FrameBuffer.Reset();
+}
+
+void FAefDeepSyncSyntheticServer::ReceiveCommands()
+{
+	for (int32 i = CommandClients.Num() - 1; i >= 0; --i)
+	{
+		FClient& Client = CommandClients[i];
+		if (Client.Socket->GetConnectionState() != ESocketConnectionState::SCS_Connected)
+		{
+			UE_LOG(LogAefDeepSync, Log, TEXT("Synthetic server: command client disconnected"));
+			CloseClient(Client);
+			CommandClients.RemoveAtSwap(i);
+			continue;
+		}
+		ReadCommands(Client);
+	}
+
+	// Duplex clients send their commands on the data connection
+	for (FClient& Client : DataClients)
+	{
+		ReadCommands(Client);
+	}
+}
+
+void FAefDeepSyncSyntheticServer::ReadCommands(FClient& Client)
+{
+	uint32 PendingSize = 0;
+	while (Client.Socket->HasPendingData(PendingSize) && PendingSize > 0)
+	{
+		ReceiveScratch.SetNumUninitialized(FMath::Min<uint32>(PendingSize, 64 * 1024));
+		int32 Read = 0;
+		if (!Client.Socket->Recv(ReceiveScratch.GetData(), ReceiveScratch.Num(), Read) || Read <= 0)
+		{
+			break;
+		}
+		Client.CommandBuffer.Append(ReceiveScratch.GetData(), Read);
+	}
+
+	// Commands are 'X'-delimited JSON like the data stream
+	int32 Start = 0;
+	for (int32 Index = 0; Index < Client.CommandBuffer.Num(); ++Index)
+	{
+		if (Client.CommandBuffer[Index] != 'X')
+		{
+			continue;
+		}
+		if (Index > Start)
+		{
+			FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Client.CommandBuffer.GetData() + Start), Index - Start);
+			ApplyCommand(FString(Converter.Length(), Converter.Get()));
+		}
+		Start = Index + 1;
+	}
+	Client.CommandBuffer.RemoveAt(0, Start, EAllowShrinking::No);
+}
+
+void FAefDeepSyncSyntheticServer::ApplyCommand(const FString& JsonCommand)
+{
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonCommand);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		UE_LOG(LogAefDeepSync, Warning, TEXT("Synthetic server: invalid command %s"), *JsonCommand);
+		return;
+	}
+
+	// Heartbeat: the pong goes out in-band with the next frames, so a held back stream delays it too
+	FString Type;
+	JsonObject->TryGetStringField(TEXT("type"), Type);
+	if (Type == TEXT("ping"))
+	{
+		TAnsiStringBuilder<64> Pong;
+		Pong.Appendf("{\"type\":\"pong\",\"Seq\":%d}X", JsonObject->GetIntegerField(TEXT("Seq")));
+		FrameBuffer.Append(reinterpret_cast<const uint8*>(Pong.GetData()), Pong.Len());
+		return;
+	}
+
+	++CommandsReceived;
+
+	// Group commands address several wearables with "Ids"
+	TArray<int32, TInlineAllocator<16>> TargetIds;
+	const TArray<TSharedPtr<FJsonValue>>* IdValues = nullptr;
+	if (JsonObject->TryGetArrayField(TEXT("Ids"), IdValues))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *IdValues)
+		{
+			TargetIds.Add(static_cast<int32>(Value->AsNumber()));
+		}
+	}
+	else
+	{
+		TargetIds.Add(JsonObject->GetIntegerField(TEXT("Id")));
+	}
+
+	auto ReadColor = [](const TSharedPtr<FJsonObject>& Object) -> FLinearColor
+	{
+		return FAefDeepSyncColor(
+			static_cast<uint8>(FMath::Clamp(Object->GetIntegerField(TEXT("R")), 0, 255)),
+			static_cast<uint8>(FMath::Clamp(Object->GetIntegerField(TEXT("G")), 0, 255)),
+			static_cast<uint8>(FMath::Clamp(Object->GetIntegerField(TEXT("B")), 0, 255))).ToLinearColor();
+	};
+
+	for (int32 TargetId : TargetIds)
+	{
+		FSimWearable* Wearable = Wearables.FindByPredicate([TargetId](const FSimWearable& W) { return W.WearableId == TargetId; });
+		if (!Wearable)
+		{
+			continue;
+		}
+
+		// Echo: the change shows up in the wearable's next frames
+		const TSharedPtr<FJsonObject>* ColorObject = nullptr;
+		if (Type == TEXT("id"))
+		{
+			Wearable->WearableId = JsonObject->GetIntegerField(TEXT("NewId"));
+		}
+		else if (Type == TEXT("effect"))
+		{
+			const FString EffectName = JsonObject->GetStringField(TEXT("Effect"));
+			const TSharedPtr<FJsonObject>* FromObject = nullptr;
+			const TSharedPtr<FJsonObject>* ToObject = nullptr;
+			Wearable->bHasEffect = EffectName != TEXT("none") &&
+				JsonObject->TryGetObjectField(TEXT("From"), FromObject) &&
+				JsonObject->TryGetObjectField(TEXT("To"), ToObject);
+			if (Wearable->bHasEffect)
+			{
+				FAefLedEffect Effect;
+				Effect.Type = EffectName == TEXT("fade") ? EAefLedEffectType::Fade
+					: EffectName == TEXT("pulse") ? EAefLedEffectType::Pulse
+					: EffectName == TEXT("heartrate") ? EAefLedEffectType::HeartRatePulse
+					: EAefLedEffectType::Solid;
+				Effect.FromColor = ReadColor(*FromObject);
+				Effect.ToColor = ReadColor(*ToObject);
+				Effect.Duration = static_cast<float>(JsonObject->GetNumberField(TEXT("Duration")));
+				Effect.Repeat = JsonObject->GetIntegerField(TEXT("Repeat"));
+				Wearable->Effect.Start(Effect, FPlatformTime::Seconds() - StartTime);
+			}
+		}
+		else if (JsonObject->TryGetObjectField(TEXT("Color"), ColorObject))
+		{
+			const FAefDeepSyncColor Color = FAefDeepSyncColor::FromLinearColor(ReadColor(*ColorObject));
+			Wearable->R = Color.R;
+			Wearable->G = Color.G;
+			Wearable->B = Color.B;
+			Wearable->bHasEffect = false;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------
+// Console Commands
+//--------------------------------------------------------------------------------
+
+static TUniquePtr<FAefDeepSyncSyntheticServer> GAefConsoleSyntheticServer;
+
+void FAefDeepSyncSyntheticServer::ShutdownConsoleInstance()
+{
+	GAefConsoleSyntheticServer.Reset();
+}
+
+static void StartConsoleSyntheticServer(const TArray<FString>& Args)
+{
+	if (!GAefConsoleSyntheticServer)
+	{
+		GAefConsoleSyntheticServer = MakeUnique<FAefDeepSyncSyntheticServer>();
+	}
+	GAefConsoleSyntheticServer->Start(FAefSyntheticServerSettings::Parse(*FString::Join(Args, TEXT(" "))));
+}
+
+static void LogConsoleSyntheticServerStats()
+{
+	if (!GAefConsoleSyntheticServer || !GAefConsoleSyntheticServer->IsRunning())
+	{
+		UE_LOG(LogAefDeepSync, Display, TEXT("Synthetic server: not running"));
+		return;
+	}
+
+	UE_LOG(LogAefDeepSync, Display, TEXT("Synthetic server: %d clients, %lld frames, %.1f MB sent, %lld commands"),
+		GAefConsoleSyntheticServer->GetClientCount(), GAefConsoleSyntheticServer->GetFramesSent(),
+		GAefConsoleSyntheticServer->GetBytesSent() / (1024.0 * 1024.0), GAefConsoleSyntheticServer->GetCommandsReceived());
+}
+
+static FAutoConsoleCommand GAefSyntheticServerStartCommand(
+	TEXT("AefDeepSync.SyntheticServer.Start"),
+	TEXT("Start a local synthetic DeepSync server. Args: [Wearables=16] [Rate=10] [Jitter=5] [Dropouts=0] [DropoutDuration=3] [Bursts=0] [BurstDuration=0.25] [FirstId=1] [Seed=1234] [ReceiverPort=43397] [SenderPort=43396]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&StartConsoleSyntheticServer));
+
+static FAutoConsoleCommand GAefSyntheticServerStopCommand(
+	TEXT("AefDeepSync.SyntheticServer.Stop"),
+	TEXT("Stop the local synthetic DeepSync server"),
+	FConsoleCommandDelegate::CreateStatic(&FAefDeepSyncSyntheticServer::ShutdownConsoleInstance));
+
+static FAutoConsoleCommand GAefSyntheticServerStatsCommand(
+	TEXT("AefDeepSync.SyntheticServer.Stats"),
+	TEXT("Log clients, frames and bytes sent by the local synthetic DeepSync server"),
+	FConsoleCommandDelegate::CreateStatic(&LogConsoleSyntheticServerStats));
+
+#endif // !UE_BUILD_SHIPPING
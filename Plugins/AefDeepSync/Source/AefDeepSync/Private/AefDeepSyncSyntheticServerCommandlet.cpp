@@ -0,0 +1,62 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Synthetic Server Commandlet Implementation
+========================================================================*/
+
+#include "AefDeepSyncSyntheticServerCommandlet.h"
+#include "AefDeepSyncSyntheticServer.h"
+#include "AefDeepSyncTypes.h"
+#include "Misc/Parse.h"
+
+UAefDeepSyncSyntheticServerCommandlet::UAefDeepSyncSyntheticServerCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UAefDeepSyncSyntheticServerCommandlet::Main(const FString& Params)
+{
+#if UE_BUILD_SHIPPING
+	UE_LOG(LogAefDeepSync, Error, TEXT("Synthetic server is not available in Shipping builds"));
+	return 1;
+#else
+	float Duration = 0.0f;
+	FParse::Value(*Params, TEXT("Duration="), Duration);
+
+	FAefDeepSyncSyntheticServer Server;
+	if (!Server.Start(FAefSyntheticServerSettings::Parse(*Params)))
+	{
+		return 1;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	double LastReportTime = StartTime;
+	int64 LastFrames = 0;
+	int64 LastBytes = 0;
+
+	while (!IsEngineExitRequested() && (Duration <= 0.0f || FPlatformTime::Seconds() - StartTime < Duration))
+	{
+		FPlatformProcess::Sleep(0.1f);
+
+		const double Now = FPlatformTime::Seconds();
+		if (Now - LastReportTime >= 5.0)
+		{
+			const double Seconds = Now - LastReportTime;
+			const int64 Frames = Server.GetFramesSent();
+			const int64 Bytes = Server.GetBytesSent();
+			UE_LOG(LogAefDeepSync, Display, TEXT("Synthetic server: %d clients, %.0f frames/s, %.2f MB/s, %lld commands"),
+				Server.GetClientCount(), (Frames - LastFrames) / Seconds,
+				(Bytes - LastBytes) / Seconds / (1024.0 * 1024.0), Server.GetCommandsReceived());
+			LastReportTime = Now;
+			LastFrames = Frames;
+			LastBytes = Bytes;
+		}
+	}
+
+	Server.Shutdown();
+	return 0;
+#endif
+}
@@ -0,0 +1,85 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Trace Implementation
+========================================================================*/
+
+#include "AefDeepSyncTrace.h"
+
+#if AEFDEEPSYNC_TRACE_ENABLED
+
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(AefDeepSyncChannel);
+
+UE_TRACE_EVENT_BEGIN(AefDeepSync, Receive)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int32, NumBytes)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(AefDeepSync, Message)
+	UE_TRACE_EVENT_FIELD(uint64, ReceivedCycle)
+	UE_TRACE_EVENT_FIELD(uint64, FramedCycle)
+	UE_TRACE_EVENT_FIELD(uint64, ParsedCycle)
+	UE_TRACE_EVENT_FIELD(uint64, DispatchedCycle)
+	UE_TRACE_EVENT_FIELD(int32, WearableId)
+	UE_TRACE_EVENT_FIELD(int32, ServerTimestamp)
+	UE_TRACE_EVENT_FIELD(int32, NumChars)
+UE_TRACE_EVENT_END()
+
+namespace
+{
+	/** Trace counter per wearable, created on first heart rate (game thread only) */
+	TMap<int32, uint16> HeartRateCounters;
+}
+
+void FAefDeepSyncTrace::OutputReceive(int32 NumBytes)
+{
+	UE_TRACE_LOG(AefDeepSync, Receive, AefDeepSyncChannel)
+		<< Receive.Cycle(FPlatformTime::Cycles64())
+		<< Receive.NumBytes(NumBytes);
+}
+
+void FAefDeepSyncTrace::OutputMessage(const FAefTraceMessageStages& Stages, int32 WearableId, int32 ServerTimestamp, int32 NumChars)
+{
+	UE_TRACE_LOG(AefDeepSync, Message, AefDeepSyncChannel)
+		<< Message.ReceivedCycle(Stages.ReceivedCycle)
+		<< Message.FramedCycle(Stages.FramedCycle)
+		<< Message.ParsedCycle(Stages.ParsedCycle)
+		<< Message.DispatchedCycle(FPlatformTime::Cycles64())
+		<< Message.WearableId(WearableId)
+		<< Message.ServerTimestamp(ServerTimestamp)
+		<< Message.NumChars(NumChars);
+}
+
+void FAefDeepSyncTrace::OutputHeartRate(int32 WearableId, int32 HeartRate)
+{
+#if COUNTERSTRACE_ENABLED
+	uint16* CounterId = HeartRateCounters.Find(WearableId);
+	if (!CounterId)
+	{
+		const FString CounterName = FString::Printf(TEXT("AefDeepSync/HeartRate/%d"), WearableId);
+		CounterId = &HeartRateCounters.Add(WearableId,
+			FCountersTrace::OutputInitCounter(*CounterName, TraceCounterType_Int, TraceCounterDisplayHint_None));
+	}
+	FCountersTrace::OutputSetValue(*CounterId, static_cast<int64>(HeartRate));
+#endif
+}
+
+void FAefDeepSyncTrace::OutputConnectionStatus(const TCHAR* StatusName)
+{
+	TRACE_BOOKMARK(TEXT("DeepSync %s"), StatusName);
+}
+
+void FAefDeepSyncTrace::OutputLinkEvent(const TCHAR* EventName, int32 LinkId, int32 PharusTrackID, int32 WearableId)
+{
+	TRACE_BOOKMARK(TEXT("DeepSync Link %s [%d: Track=%d <-> Wearable=%d]"), EventName, LinkId, PharusTrackID, WearableId);
+}
+
+void FAefDeepSyncTrace::Reset()
+{
+	HeartRateCounters.Reset();
+}
+
+#endif
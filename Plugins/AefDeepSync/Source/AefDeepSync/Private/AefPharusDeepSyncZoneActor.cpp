@@ -6,8 +6,9 @@
 
 #include "AefPharusDeepSyncZoneActor.h"
 #include "AefDeepSyncSubsystem.h"
+#include "AefDeepSyncStats.h"
 #include "AefPharusSubsystem.h"
-#include "AefPharusActorInterface.h"
+#include "AefPharusTrackAccessor.h"
 #include "Components/SphereComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
@@ -19,8 +20,8 @@ DEFINE_LOG_CATEGORY_STATIC(LogAefPharusSync, Log, All);
 
 AAefPharusDeepSyncZoneActor::AAefPharusDeepSyncZoneActor()
 {
-	PrimaryActorTick.bCanEverTick = true;
-	PrimaryActorTick.bStartWithTickEnabled = true;
+	// Sync progress is driven by UAefDeepSyncSubsystem, idle zones never tick
+	PrimaryActorTick.bCanEverTick = false;
 
 	// Create root trigger sphere
 	TriggerSphere = CreateDefaultSubobject<USphereComponent>(TEXT("TriggerSphere"));
@@ -48,20 +49,20 @@ void AAefPharusDeepSyncZoneActor::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Bind overlap events
-	TriggerSphere->OnComponentBeginOverlap.AddDynamic(this, &AAefPharusDeepSyncZoneActor::OnTriggerBeginOverlap);
-	TriggerSphere->OnComponentEndOverlap.AddDynamic(this, &AAefPharusDeepSyncZoneActor::OnTriggerEndOverlap);
-
 	// Setup visuals
 	SetupComponents();
 	UpdateMaterialColor();
 
 	// Register with subsystem
-	if (UAefDeepSyncSubsystem* Subsystem = GetDeepSyncSubsystem())
+	UAefDeepSyncSubsystem* Subsystem = GetDeepSyncSubsystem();
+	if (Subsystem)
 	{
 		Subsystem->RegisterZone(this);
 	}
 
+	// Bind overlap events, or leave detection to the subsystem's spatial hash
+	ApplyZoneDetectionMode(Subsystem && Subsystem->UsesSpatialZoneDetection());
+
 	// Auto-activate if configured
 	if (bAutoActivate)
 	{
@@ -74,7 +75,7 @@ void AAefPharusDeepSyncZoneActor::BeginPlay()
 
 void AAefPharusDeepSyncZoneActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	// Unregister from subsystem
+	// Unregister from subsystem (also drops a running sync session)
 	if (UAefDeepSyncSubsystem* Subsystem = GetDeepSyncSubsystem())
 	{
 		Subsystem->UnregisterZone(this);
@@ -83,58 +84,6 @@ void AAefPharusDeepSyncZoneActor::EndPlay(const EEndPlayReason::Type EndPlayReas
 	Super::EndPlay(EndPlayReason);
 }
 
-void AAefPharusDeepSyncZoneActor::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-	if (!bIsActive || !bIsSyncing)
-	{
-		return;
-	}
-
-	// Check if Pharus track is still valid
-	if (CurrentPharusTrackID >= 0)
-	{
-		UAefPharusSubsystem* PharusSub = GetPharusSubsystem();
-		if (PharusSub)
-		{
-			// Check if track still exists via the subsystem
-			// Note: We rely on EndOverlap for track loss, but also check wearable
-		}
-	}
-
-	// Check if wearable is still connected
-	UAefDeepSyncSubsystem* DeepSyncSub = GetDeepSyncSubsystem();
-	if (DeepSyncSub && !DeepSyncSub->IsWearableActive(WearableId))
-	{
-		UE_LOG(LogAefPharusSync, Warning, TEXT("SyncZone [WearableId=%d]: Wearable lost during sync!"), WearableId);
-		OnWearableLost.Broadcast(WearableId);
-		FailSync(EAefPharusSyncStatus::Failed, TEXT("Wearable connection lost"));
-		return;
-	}
-
-	// Update sync progress
-	SyncElapsedTime += DeltaTime;
-	CurrentSyncProgress = FMath::Clamp(SyncElapsedTime / SyncDuration, 0.0f, 1.0f);
-	SyncTimeRemaining = FMath::Max(0.0f, SyncDuration - SyncElapsedTime);
-
-	// Broadcast progress
-	OnSyncing.Broadcast(CurrentPharusTrackID, CurrentSyncProgress);
-
-	if (bShowDebugInfo)
-	{
-		GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Green,
-			FString::Printf(TEXT("Sync [%d -> %d]: %.0f%% (%.1fs remaining)"),
-				CurrentPharusTrackID, WearableId, CurrentSyncProgress * 100.0f, SyncTimeRemaining));
-	}
-
-	// Check if sync is complete
-	if (SyncElapsedTime >= SyncDuration)
-	{
-		CompleteSync();
-	}
-}
-
 void AAefPharusDeepSyncZoneActor::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
@@ -204,20 +153,57 @@ void AAefPharusDeepSyncZoneActor::UpdateMaterialColor()
 	}
 }
 
+void AAefPharusDeepSyncZoneActor::ApplyZoneDetectionMode(bool bSpatialDetection)
+{
+	const bool bModeChanged = bUseOverlapDetection == bSpatialDetection;
+	bUseOverlapDetection = !bSpatialDetection;
+
+	// Tracks found by the previous mode would never be reported as leaving by the new one
+	if (bModeChanged)
+	{
+		SyncCandidates.Reset();
+		CancelSync();
+		EndSessionIfIdle();
+	}
+
+	if (bUseOverlapDetection)
+	{
+		TriggerSphere->OnComponentBeginOverlap.AddUniqueDynamic(this, &AAefPharusDeepSyncZoneActor::OnTriggerBeginOverlap);
+		TriggerSphere->OnComponentEndOverlap.AddUniqueDynamic(this, &AAefPharusDeepSyncZoneActor::OnTriggerEndOverlap);
+		TriggerSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		TriggerSphere->SetGenerateOverlapEvents(bIsActive);
+		if (bModeChanged)
+		{
+			// Tracks already inside get their BeginOverlap now
+			TriggerSphere->UpdateOverlaps();
+		}
+	}
+	else
+	{
+		TriggerSphere->OnComponentBeginOverlap.RemoveDynamic(this, &AAefPharusDeepSyncZoneActor::OnTriggerBeginOverlap);
+		TriggerSphere->OnComponentEndOverlap.RemoveDynamic(this, &AAefPharusDeepSyncZoneActor::OnTriggerEndOverlap);
+		TriggerSphere->SetGenerateOverlapEvents(false);
+		TriggerSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+}
+
 void AAefPharusDeepSyncZoneActor::ActivateZone()
 {
 	bIsActive = true;
-	TriggerSphere->SetGenerateOverlapEvents(true);
+	TriggerSphere->SetGenerateOverlapEvents(bUseOverlapDetection);
 	UE_LOG(LogAefPharusSync, Log, TEXT("SyncZone [WearableId=%d] activated"), WearableId);
 }
 
 void AAefPharusDeepSyncZoneActor::DeactivateZone()
 {
+	// Inactive first so the cancel below does not hand over to the next candidate
+	bIsActive = false;
 	if (bIsSyncing)
 	{
 		CancelSync();
 	}
-	bIsActive = false;
+	SyncCandidates.Reset();
+	EndSessionIfIdle();
 	TriggerSphere->SetGenerateOverlapEvents(false);
 	UE_LOG(LogAefPharusSync, Log, TEXT("SyncZone [WearableId=%d] deactivated"), WearableId);
 }
@@ -230,17 +216,23 @@ void AAefPharusDeepSyncZoneActor::CancelSync()
 	}
 
 	int32 CancelledTrackID = CurrentPharusTrackID;
-	
-	bIsSyncing = false;
-	CurrentSyncProgress = 0.0f;
-	SyncTimeRemaining = 0.0f;
-	SyncElapsedTime = 0.0f;
-	CurrentPharusTrackID = -1;
-	OverlappingActor.Reset();
+	ResetSyncState();
+
+	// A cancelled track still in the zone is not picked again until it re-enters
+	const int32 CandidateIndex = FindCandidateIndex(CancelledTrackID);
+	if (CandidateIndex != INDEX_NONE)
+	{
+		SyncCandidates[CandidateIndex].PresenceTime = 0.0f;
+		SyncCandidates[CandidateIndex].bSyncCancelled = true;
+	}
 
 	OnSyncCancelled.Broadcast(CancelledTrackID);
 	UE_LOG(LogAefPharusSync, Log, TEXT("SyncZone [WearableId=%d]: Sync cancelled for TrackID=%d"), 
 		WearableId, CancelledTrackID);
+
+	// Hand over to the next track waiting in the zone
+	ArbitrateSync(false);
+	EndSessionIfIdle();
 }
 
 void AAefPharusDeepSyncZoneActor::SetZoneColor(FLinearColor NewColor)
@@ -252,81 +244,135 @@ void AAefPharusDeepSyncZoneActor::SetZoneColor(FLinearColor NewColor)
 void AAefPharusDeepSyncZoneActor::OnTriggerBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
 	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
-	if (!bIsActive || bIsSyncing || !OtherActor)
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_ZoneOverlap);
+	NotifyPharusActorEntered(OtherActor);
+}
+
+void AAefPharusDeepSyncZoneActor::OnTriggerEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AefDeepSync_ZoneOverlap);
+
+	if (!OtherActor)
+	{
+		return;
+	}
+
+	const int32 CandidateIndex = FindCandidateIndex(OtherActor);
+	if (CandidateIndex != INDEX_NONE)
+	{
+		RemoveCandidateAt(CandidateIndex);
+	}
+}
+
+void AAefPharusDeepSyncZoneActor::NotifyPharusActorEntered(AActor* PharusActor)
+{
+	if (!bIsActive || !PharusActor)
 	{
 		return;
 	}
 
 	int32 TrackID = -1;
-	if (ValidatePharusActor(OtherActor, TrackID))
+	if (!ValidatePharusActor(PharusActor, TrackID) || FindCandidateIndex(TrackID) != INDEX_NONE)
+	{
+		return;
+	}
+
+	UAefDeepSyncSubsystem* DeepSyncSub = GetDeepSyncSubsystem();
+	if (!DeepSyncSub)
+	{
+		UE_LOG(LogAefPharusSync, Warning, TEXT("SyncZone [WearableId=%d]: DeepSync subsystem not available"), WearableId);
+		return;
+	}
+
+	FAefZoneSyncCandidate& Candidate = SyncCandidates.AddDefaulted_GetRef();
+	Candidate.TrackID = TrackID;
+	Candidate.PharusActor = PharusActor;
+	DeepSyncSub->BeginZoneSession(this, PharusActor);
+
+	ArbitrateSync(false);
+}
+
+void AAefPharusDeepSyncZoneActor::NotifyPharusTrackLeft(int32 TrackID)
+{
+	const int32 CandidateIndex = FindCandidateIndex(TrackID);
+	if (CandidateIndex != INDEX_NONE)
 	{
-		StartSync(TrackID, OtherActor);
+		RemoveCandidateAt(CandidateIndex);
 	}
 }
 
-void AAefPharusDeepSyncZoneActor::OnTriggerEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+void AAefPharusDeepSyncZoneActor::HandlePharusActorRemoved(AActor* PharusActor)
 {
-	if (!bIsSyncing || !OtherActor)
+	const int32 CandidateIndex = FindCandidateIndex(PharusActor);
+	if (CandidateIndex == INDEX_NONE)
 	{
 		return;
 	}
 
-	// Check if this is the actor that was syncing
-	if (OverlappingActor.IsValid() && OverlappingActor.Get() == OtherActor)
+	const bool bWasSyncing = bIsSyncing && SyncCandidates[CandidateIndex].TrackID == CurrentPharusTrackID;
+	SyncCandidates.RemoveAt(CandidateIndex);
+
+	if (bWasSyncing)
 	{
-		UE_LOG(LogAefPharusSync, Log, TEXT("SyncZone [WearableId=%d]: Pharus actor left zone, cancelling sync"), WearableId);
-		CancelSync();
+		HandleSyncPharusTrackLost();
+		ArbitrateSync(false);
 	}
+	EndSessionIfIdle();
 }
 
-void AAefPharusDeepSyncZoneActor::StartSync(int32 TrackID, AActor* PharusActor)
+bool AAefPharusDeepSyncZoneActor::StartSync(int32 TrackID, AActor* PharusActor, float InitialElapsedTime, bool bQuiet)
 {
 	UAefDeepSyncSubsystem* DeepSyncSub = GetDeepSyncSubsystem();
 	if (!DeepSyncSub)
 	{
 		UE_LOG(LogAefPharusSync, Warning, TEXT("SyncZone [WearableId=%d]: DeepSync subsystem not available"), WearableId);
-		return;
+		return false;
 	}
 
-	// Blocking checks - cannot sync if already linked
+	// Blocking checks - cannot sync if already linked (quiet retries skip the logs)
 	if (DeepSyncSub->IsZoneBlocked(this))
 	{
-		UE_LOG(LogAefPharusSync, Log, TEXT("SyncZone [WearableId=%d]: Zone is blocked (already synced)"), WearableId);
-		return;
+		UE_CLOG(!bQuiet, LogAefPharusSync, Log, TEXT("SyncZone [WearableId=%d]: Zone is blocked (already synced)"), WearableId);
+		return false;
 	}
 
 	if (DeepSyncSub->IsPharusTrackBlocked(TrackID))
 	{
-		UE_LOG(LogAefPharusSync, Log, TEXT("SyncZone [WearableId=%d]: TrackID=%d is blocked (already synced)"), WearableId, TrackID);
-		return;
+		UE_CLOG(!bQuiet, LogAefPharusSync, Log, TEXT("SyncZone [WearableId=%d]: TrackID=%d is blocked (already synced)"), WearableId, TrackID);
+		return false;
 	}
 
 	if (DeepSyncSub->IsWearableBlocked(WearableId))
 	{
-		UE_LOG(LogAefPharusSync, Log, TEXT("SyncZone [WearableId=%d]: Wearable is blocked (already synced)"), WearableId);
-		return;
+		UE_CLOG(!bQuiet, LogAefPharusSync, Log, TEXT("SyncZone [WearableId=%d]: Wearable is blocked (already synced)"), WearableId);
+		return false;
 	}
 
 	// Check if wearable is available
 	if (!DeepSyncSub->IsWearableActive(WearableId))
 	{
-		UE_LOG(LogAefPharusSync, Warning, TEXT("SyncZone [WearableId=%d]: Wearable not active, cannot start sync"), WearableId);
-		OnWearableLost.Broadcast(WearableId);
-		return;
+		if (!bQuiet)
+		{
+			UE_LOG(LogAefPharusSync, Warning, TEXT("SyncZone [WearableId=%d]: Wearable not active, cannot start sync"), WearableId);
+			OnWearableLost.Broadcast(WearableId);
+		}
+		return false;
 	}
 
-	// Start sync
+	// Start sync (a waiting candidate keeps the presence time it already has)
 	bIsSyncing = true;
 	CurrentPharusTrackID = TrackID;
-	SyncElapsedTime = 0.0f;
-	CurrentSyncProgress = 0.0f;
-	SyncTimeRemaining = SyncDuration;
+	SyncElapsedTime = InitialElapsedTime;
+	CurrentSyncProgress = FMath::Clamp(SyncElapsedTime / SyncDuration, 0.0f, 1.0f);
+	SyncTimeRemaining = FMath::Max(0.0f, SyncDuration - SyncElapsedTime);
 	OverlappingActor = PharusActor;
+	DeepSyncSub->BeginZoneSession(this, PharusActor);
 
 	OnSyncStarted.Broadcast(TrackID);
-	UE_LOG(LogAefPharusSync, Log, TEXT("SyncZone [WearableId=%d]: Sync started for TrackID=%d (%.1fs duration)"), 
-		WearableId, TrackID, SyncDuration);
+	UE_LOG(LogAefPharusSync, Log, TEXT("SyncZone [WearableId=%d]: Sync started for TrackID=%d (%.1fs duration, %.1fs already present)"), 
+		WearableId, TrackID, SyncDuration, InitialElapsedTime);
+	return true;
 }
 
 void AAefPharusDeepSyncZoneActor::CompleteSync()
@@ -364,13 +410,9 @@ void AAefPharusDeepSyncZoneActor::CompleteSync()
 
 	// Reset state
 	int32 CompletedTrackID = CurrentPharusTrackID;
-	bIsSyncing = false;
-	CurrentSyncProgress = 1.0f;
-	SyncTimeRemaining = 0.0f;
-	SyncElapsedTime = 0.0f;
 	AActor* CachedPharusActor = OverlappingActor.Get();
-	CurrentPharusTrackID = -1;
-	OverlappingActor.Reset();
+	ResetSyncState();
+	CurrentSyncProgress = 1.0f;
 
 	// Notify subsystem to create link
 	DeepSyncSub->NotifySyncCompleted(Result, this, CachedPharusActor);
@@ -378,6 +420,7 @@ void AAefPharusDeepSyncZoneActor::CompleteSync()
 	OnSyncCompleted.Broadcast(Result);
 	UE_LOG(LogAefPharusSync, Log, TEXT("SyncZone [WearableId=%d]: Sync COMPLETED for TrackID=%d, HR=%d"), 
 		WearableId, CompletedTrackID, WearableData.HeartRate);
+	EndSessionIfIdle();
 }
 
 void AAefPharusDeepSyncZoneActor::FailSync(EAefPharusSyncStatus Status, const FString& Error)
@@ -390,57 +433,211 @@ void AAefPharusDeepSyncZoneActor::FailSync(EAefPharusSyncStatus Status, const FS
 	);
 
 	int32 FailedTrackID = CurrentPharusTrackID;
+	ResetSyncState();
+
+	OnSyncCompleted.Broadcast(Result);
+	UE_LOG(LogAefPharusSync, Warning, TEXT("SyncZone [WearableId=%d]: Sync FAILED for TrackID=%d: %s"), 
+		WearableId, FailedTrackID, *Error);
+	EndSessionIfIdle();
+}
+
+void AAefPharusDeepSyncZoneActor::ResetSyncState()
+{
 	bIsSyncing = false;
 	CurrentSyncProgress = 0.0f;
 	SyncTimeRemaining = 0.0f;
 	SyncElapsedTime = 0.0f;
 	CurrentPharusTrackID = -1;
 	OverlappingActor.Reset();
+}
 
-	OnSyncCompleted.Broadcast(Result);
-	UE_LOG(LogAefPharusSync, Warning, TEXT("SyncZone [WearableId=%d]: Sync FAILED for TrackID=%d: %s"), 
-		WearableId, FailedTrackID, *Error);
+void AAefPharusDeepSyncZoneActor::UpdateSyncProgress()
+{
+	if (!bIsActive || !bIsSyncing)
+	{
+		return;
+	}
+
+	// Update sync progress from the presence time of the syncing track
+	const int32 CandidateIndex = FindCandidateIndex(CurrentPharusTrackID);
+	if (CandidateIndex != INDEX_NONE)
+	{
+		SyncElapsedTime = SyncCandidates[CandidateIndex].PresenceTime;
+	}
+	CurrentSyncProgress = FMath::Clamp(SyncElapsedTime / SyncDuration, 0.0f, 1.0f);
+	SyncTimeRemaining = FMath::Max(0.0f, SyncDuration - SyncElapsedTime);
+
+	// Broadcast progress
+	OnSyncing.Broadcast(CurrentPharusTrackID, CurrentSyncProgress);
+
+	if (bShowDebugInfo && GEngine)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Green,
+			FString::Printf(TEXT("Sync [%d -> %d]: %.0f%% (%.1fs remaining)"),
+				CurrentPharusTrackID, WearableId, CurrentSyncProgress * 100.0f, SyncTimeRemaining));
+	}
+
+	// Check if sync is complete (a progress handler may have cancelled it)
+	if (bIsSyncing && SyncElapsedTime >= SyncDuration)
+	{
+		CompleteSync();
+	}
 }
 
-bool AAefPharusDeepSyncZoneActor::ValidatePharusActor(AActor* Actor, int32& OutTrackID)
+void AAefPharusDeepSyncZoneActor::HandleSyncWearableLost()
 {
-	if (!Actor)
+	if (!bIsSyncing)
 	{
-		return false;
+		return;
 	}
 
-	// Check if actor implements IAefPharusActorInterface
-	// We need to cast to AAefPharusActor to get the TrackID
-	// The interface doesn't have a GetActorTrackID method, but AAefPharusActor has GetTrackID()
-	
-	// First check if it's directly an AAefPharusActor (or derived)
-	// We use the interface check to be more generic
-	if (Actor->GetClass()->ImplementsInterface(UAefPharusActorInterface::StaticClass()))
-	{
-		// Try to get TrackID via reflection (AAefPharusActor stores it as a UPROPERTY)
-		// This works because AAefPharusActor has a BlueprintReadOnly TrackID property
-		
-		// Use FindPropertyByName to get the track ID
-		if (FProperty* TrackIDProp = Actor->GetClass()->FindPropertyByName(TEXT("TrackID")))
+	UE_LOG(LogAefPharusSync, Warning, TEXT("SyncZone [WearableId=%d]: Wearable lost during sync!"), WearableId);
+	OnWearableLost.Broadcast(WearableId);
+	FailSync(EAefPharusSyncStatus::Failed, TEXT("Wearable connection lost"));
+}
+
+void AAefPharusDeepSyncZoneActor::HandleSyncPharusTrackLost()
+{
+	if (!bIsSyncing)
+	{
+		return;
+	}
+
+	const int32 LostTrackID = CurrentPharusTrackID;
+	UE_LOG(LogAefPharusSync, Warning, TEXT("SyncZone [WearableId=%d]: Pharus track %d lost during sync!"), WearableId, LostTrackID);
+	OnPharusTrackLost.Broadcast(LostTrackID);
+	FailSync(EAefPharusSyncStatus::Failed, TEXT("Pharus track lost"));
+}
+
+//--------------------------------------------------------------------------------
+// Sync Candidates
+//--------------------------------------------------------------------------------
+
+void AAefPharusDeepSyncZoneActor::AdvanceSyncCandidates(float DeltaTime)
+{
+	// Drop tracks whose actor vanished without EndPlay/EndOverlap (e.g. garbage collected)
+	for (int32 i = SyncCandidates.Num() - 1; i >= 0; --i)
+	{
+		if (SyncCandidates.IsValidIndex(i) && !SyncCandidates[i].PharusActor.IsValid())
 		{
-			if (const FIntProperty* IntProp = CastField<FIntProperty>(TrackIDProp))
-			{
-				OutTrackID = IntProp->GetPropertyValue_InContainer(Actor);
-				return OutTrackID >= 0;
-			}
+			RemoveCandidateAt(i);
 		}
-		
-		// Fallback: Try to call GetTrackID function if it exists
-		if (UFunction* GetTrackIDFunc = Actor->FindFunction(TEXT("GetTrackID")))
+	}
+
+	for (FAefZoneSyncCandidate& Candidate : SyncCandidates)
+	{
+		Candidate.PresenceTime += DeltaTime;
+	}
+
+	// Retry quietly each frame, the wearable may come online or a link may break
+	ArbitrateSync(true);
+}
+
+void AAefPharusDeepSyncZoneActor::ArbitrateSync(bool bQuiet)
+{
+	if (!bIsActive || bIsSyncing)
+	{
+		return;
+	}
+
+	const int32 BestIndex = FindBestCandidateIndex();
+	if (BestIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FAefZoneSyncCandidate Candidate = SyncCandidates[BestIndex];
+	StartSync(Candidate.TrackID, Candidate.PharusActor.Get(), Candidate.PresenceTime, bQuiet);
+}
+
+int32 AAefPharusDeepSyncZoneActor::FindBestCandidateIndex()
+{
+	UAefDeepSyncSubsystem* DeepSyncSub = GetDeepSyncSubsystem();
+	const FVector ZoneCenter = GetActorLocation();
+
+	int32 BestIndex = INDEX_NONE;
+	float BestScore = TNumericLimits<float>::Lowest();
+	for (int32 i = 0; i < SyncCandidates.Num(); ++i)
+	{
+		const FAefZoneSyncCandidate& Candidate = SyncCandidates[i];
+		const AActor* Actor = Candidate.PharusActor.Get();
+		if (!Actor || Candidate.bSyncCancelled)
+		{
+			continue;
+		}
+
+		// Tracks already linked elsewhere can never sync here
+		if (DeepSyncSub && DeepSyncSub->IsPharusTrackBlocked(Candidate.TrackID))
+		{
+			continue;
+		}
+
+		// Global assignment decides across zones, only the assigned track may start here
+		if (DeepSyncSub && DeepSyncSub->UsesGlobalZoneAssignment() && Candidate.TrackID != AssignedTrackID)
+		{
+			continue;
+		}
+
+		const float Score = (ArbitrationPolicy == EAefZoneArbitrationPolicy::NearestToCenter)
+			? -FVector::DistSquared2D(Actor->GetActorLocation(), ZoneCenter)
+			: Candidate.PresenceTime;
+		if (Score > BestScore)
 		{
-			struct { int32 ReturnValue; } Params;
-			Actor->ProcessEvent(GetTrackIDFunc, &Params);
-			OutTrackID = Params.ReturnValue;
-			return OutTrackID >= 0;
+			BestScore = Score;
+			BestIndex = i;
 		}
 	}
+	return BestIndex;
+}
+
+int32 AAefPharusDeepSyncZoneActor::FindCandidateIndex(int32 TrackID) const
+{
+	return SyncCandidates.IndexOfByPredicate([TrackID](const FAefZoneSyncCandidate& Candidate)
+	{
+		return Candidate.TrackID == TrackID;
+	});
+}
 
-	return false;
+int32 AAefPharusDeepSyncZoneActor::FindCandidateIndex(const AActor* PharusActor) const
+{
+	return SyncCandidates.IndexOfByPredicate([PharusActor](const FAefZoneSyncCandidate& Candidate)
+	{
+		return Candidate.PharusActor.Get() == PharusActor;
+	});
+}
+
+void AAefPharusDeepSyncZoneActor::RemoveCandidateAt(int32 Index)
+{
+	const bool bWasSyncing = bIsSyncing && SyncCandidates[Index].TrackID == CurrentPharusTrackID;
+	SyncCandidates.RemoveAt(Index);
+
+	if (bWasSyncing)
+	{
+		UE_LOG(LogAefPharusSync, Log, TEXT("SyncZone [WearableId=%d]: Pharus track left zone, cancelling sync"), WearableId);
+		CancelSync();
+	}
+	else
+	{
+		EndSessionIfIdle();
+	}
+}
+
+void AAefPharusDeepSyncZoneActor::EndSessionIfIdle()
+{
+	if (bIsSyncing || SyncCandidates.Num() > 0)
+	{
+		return;
+	}
+
+	if (UAefDeepSyncSubsystem* DeepSyncSub = GetDeepSyncSubsystem())
+	{
+		DeepSyncSub->EndZoneSession(this);
+	}
+}
+
+bool AAefPharusDeepSyncZoneActor::ValidatePharusActor(AActor* Actor, int32& OutTrackID)
+{
+	return FAefPharusTrackAccessor::GetTrackID(Actor, OutTrackID);
 }
 
 UAefDeepSyncSubsystem* AAefPharusDeepSyncZoneActor::GetDeepSyncSubsystem()
@@ -0,0 +1,146 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Pharus Track Accessor Implementation
+========================================================================*/
+
+#include "AefPharusTrackAccessor.h"
+#include "AefPharusTrackIdProvider.h"
+#include "AefPharusActorInterface.h"
+#include "GameFramework/Actor.h"
+#include "UObject/ObjectKey.h"
+
+namespace
+{
+	/** Where a class keeps its TrackID */
+	enum class EAefTrackIdSource : uint8
+	{
+		None,
+		NativeInterface,
+		Property,
+		Function
+	};
+
+	/** Resolved once per UClass */
+	struct FAefTrackIdClassEntry
+	{
+		bool bIsPharusActor = false;
+		EAefTrackIdSource Source = EAefTrackIdSource::None;
+
+		/** Interface pointer offset (NativeInterface) or property offset (Property) */
+		int32 Offset = 0;
+
+		/** Getter function (Function) */
+		TWeakObjectPtr<UFunction> Function;
+	};
+
+	TMap<TObjectKey<UClass>, FAefTrackIdClassEntry>& GetClassCache()
+	{
+		static TMap<TObjectKey<UClass>, FAefTrackIdClassEntry> ClassCache;
+		return ClassCache;
+	}
+
+	FAefTrackIdClassEntry ResolveClassEntry(const AActor* Actor)
+	{
+		const UClass* Class = Actor->GetClass();
+		FAefTrackIdClassEntry Entry;
+
+		// Native provider: offset of the interface inside the object is fixed per class
+		if (const IAefPharusTrackIdProvider* Provider = Cast<IAefPharusTrackIdProvider>(Actor))
+		{
+			Entry.bIsPharusActor = true;
+			Entry.Source = EAefTrackIdSource::NativeInterface;
+			Entry.Offset = static_cast<int32>(reinterpret_cast<const uint8*>(Provider) - reinterpret_cast<const uint8*>(Actor));
+			return Entry;
+		}
+
+		if (!Class->ImplementsInterface(UAefPharusActorInterface::StaticClass()))
+		{
+			return Entry;
+		}
+		Entry.bIsPharusActor = true;
+
+		// AAefPharusActor stores the TrackID as a BlueprintReadOnly UPROPERTY
+		if (const FIntProperty* IntProp = CastField<FIntProperty>(Class->FindPropertyByName(TEXT("TrackID"))))
+		{
+			Entry.Source = EAefTrackIdSource::Property;
+			Entry.Offset = IntProp->GetOffset_ForInternal();
+			return Entry;
+		}
+
+		// Fallback: GetTrackID() function, only if it really is "int32 GetTrackID()"
+		if (UFunction* GetTrackIDFunc = Class->FindFunctionByName(TEXT("GetTrackID")))
+		{
+			if (GetTrackIDFunc->ParmsSize == sizeof(int32) && CastField<FIntProperty>(GetTrackIDFunc->GetReturnProperty()))
+			{
+				Entry.Source = EAefTrackIdSource::Function;
+				Entry.Function = GetTrackIDFunc;
+			}
+		}
+		return Entry;
+	}
+
+	const FAefTrackIdClassEntry& FindOrAddClassEntry(const AActor* Actor)
+	{
+		TMap<TObjectKey<UClass>, FAefTrackIdClassEntry>& ClassCache = GetClassCache();
+		const TObjectKey<UClass> ClassKey(Actor->GetClass());
+		if (const FAefTrackIdClassEntry* Entry = ClassCache.Find(ClassKey))
+		{
+			return *Entry;
+		}
+		return ClassCache.Add(ClassKey, ResolveClassEntry(Actor));
+	}
+}
+
+bool FAefPharusTrackAccessor::IsPharusActor(const AActor* Actor)
+{
+	return Actor && FindOrAddClassEntry(Actor).bIsPharusActor;
+}
+
+bool FAefPharusTrackAccessor::GetTrackID(AActor* Actor, int32& OutTrackID)
+{
+	if (!Actor)
+	{
+		return false;
+	}
+
+	const FAefTrackIdClassEntry& Entry = FindOrAddClassEntry(Actor);
+	switch (Entry.Source)
+	{
+		case EAefTrackIdSource::NativeInterface:
+		{
+			const IAefPharusTrackIdProvider* Provider =
+				reinterpret_cast<const IAefPharusTrackIdProvider*>(reinterpret_cast<const uint8*>(Actor) + Entry.Offset);
+			OutTrackID = Provider->GetPharusTrackID();
+			return OutTrackID >= 0;
+		}
+
+		case EAefTrackIdSource::Property:
+		{
+			OutTrackID = *reinterpret_cast<const int32*>(reinterpret_cast<const uint8*>(Actor) + Entry.Offset);
+			return OutTrackID >= 0;
+		}
+
+		case EAefTrackIdSource::Function:
+		{
+			UFunction* GetTrackIDFunc = Entry.Function.Get();
+			if (!GetTrackIDFunc)
+			{
+				return false;
+			}
+			struct { int32 ReturnValue; } Params;
+			Params.ReturnValue = -1;
+			Actor->ProcessEvent(GetTrackIDFunc, &Params);
+			OutTrackID = Params.ReturnValue;
+			return OutTrackID >= 0;
+		}
+
+		default:
+			return false;
+	}
+}
+
+void FAefPharusTrackAccessor::ResetCache()
+{
+	GetClassCache().Reset();
+}
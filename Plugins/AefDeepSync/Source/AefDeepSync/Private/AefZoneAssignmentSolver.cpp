@@ -0,0 +1,115 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Zone Assignment Solver Implementation
+========================================================================*/
+
+#include "AefZoneAssignmentSolver.h"
+
+double FAefZoneAssignmentSolver::Solve(TConstArrayView<double> Costs, int32 NumRows, int32 NumCols, TArray<int32>& OutColumnForRow)
+{
+	OutColumnForRow.Init(INDEX_NONE, NumRows);
+	if (NumRows == 0 || NumCols == 0)
+	{
+		return 0.0;
+	}
+	check(Costs.Num() == NumRows * NumCols);
+
+	// More zones than tracks: pad with forbidden dummy columns so every row can be matched
+	const int32 NumSolveCols = FMath::Max(NumCols, NumRows);
+	auto GetCost = [&Costs, NumCols](int32 Row, int32 Col)
+	{
+		return Col < NumCols ? Costs[Row * NumCols + Col] : ForbiddenCost;
+	};
+
+	// Index 0 is the virtual start column, rows and columns are 1-based below
+	RowPotential.Init(0.0, NumRows + 1);
+	ColPotential.Init(0.0, NumSolveCols + 1);
+	RowForCol.Init(0, NumSolveCols + 1);
+	PrevCol.SetNumUninitialized(NumSolveCols + 1);
+	MinSlack.SetNumUninitialized(NumSolveCols + 1);
+	ColUsed.SetNumUninitialized(NumSolveCols + 1);
+
+	for (int32 Row = 1; Row <= NumRows; ++Row)
+	{
+		// Grow an alternating tree from Row until a free column is reached
+		RowForCol[0] = Row;
+		int32 Col0 = 0;
+		for (int32 Col = 0; Col <= NumSolveCols; ++Col)
+		{
+			MinSlack[Col] = TNumericLimits<double>::Max();
+			ColUsed[Col] = false;
+		}
+
+		do
+		{
+			ColUsed[Col0] = true;
+			const int32 Row0 = RowForCol[Col0];
+			double Delta = TNumericLimits<double>::Max();
+			int32 Col1 = 0;
+
+			for (int32 Col = 1; Col <= NumSolveCols; ++Col)
+			{
+				if (ColUsed[Col])
+				{
+					continue;
+				}
+
+				const double Slack = GetCost(Row0 - 1, Col - 1) - RowPotential[Row0] - ColPotential[Col];
+				if (Slack < MinSlack[Col])
+				{
+					MinSlack[Col] = Slack;
+					PrevCol[Col] = Col0;
+				}
+				if (MinSlack[Col] < Delta)
+				{
+					Delta = MinSlack[Col];
+					Col1 = Col;
+				}
+			}
+
+			for (int32 Col = 0; Col <= NumSolveCols; ++Col)
+			{
+				if (ColUsed[Col])
+				{
+					RowPotential[RowForCol[Col]] += Delta;
+					ColPotential[Col] -= Delta;
+				}
+				else
+				{
+					MinSlack[Col] -= Delta;
+				}
+			}
+
+			Col0 = Col1;
+		}
+		while (RowForCol[Col0] != 0);
+
+		// Flip the augmenting path
+		do
+		{
+			const int32 Col1 = PrevCol[Col0];
+			RowForCol[Col0] = RowForCol[Col1];
+			Col0 = Col1;
+		}
+		while (Col0 != 0);
+	}
+
+	double TotalCost = 0.0;
+	for (int32 Col = 1; Col <= NumCols; ++Col)
+	{
+		const int32 Row = RowForCol[Col];
+		if (Row == 0)
+		{
+			continue;
+		}
+
+		const double Cost = GetCost(Row - 1, Col - 1);
+		if (Cost < ForbiddenCost)
+		{
+			OutColumnForRow[Row - 1] = Col - 1;
+			TotalCost += Cost;
+		}
+	}
+	return TotalCost;
+}
@@ -0,0 +1,76 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Zone Spatial Hash Implementation
+========================================================================*/
+
+#include "AefZoneSpatialHash.h"
+
+void FAefZoneSpatialHash::Build(TConstArrayView<FVector2D> Centers, TConstArrayView<float> Radii, float InCellSize)
+{
+	Reset();
+	check(Centers.Num() == Radii.Num());
+
+	// Auto cell size: each zone touches at most 2x2 cells
+	float MaxRadius = 0.0f;
+	for (float Radius : Radii)
+	{
+		MaxRadius = FMath::Max(MaxRadius, Radius);
+	}
+	CellSize = InCellSize > 0.0f ? InCellSize : FMath::Max(MaxRadius * 2.0f, 10.0f);
+	InvCellSize = 1.0f / CellSize;
+
+	// Collect (cell, zone) pairs
+	struct FEntry
+	{
+		FIntPoint Cell;
+		int32 ZoneIndex;
+	};
+	TArray<FEntry> Entries;
+	Entries.Reserve(Centers.Num() * 4);
+	Circles.Reserve(Centers.Num());
+
+	for (int32 ZoneIndex = 0; ZoneIndex < Centers.Num(); ++ZoneIndex)
+	{
+		const FVector2D& Center = Centers[ZoneIndex];
+		const float Radius = Radii[ZoneIndex];
+		Circles.Add({ Center, static_cast<double>(Radius) * Radius });
+
+		const FIntPoint MinCell = ToCell(Center - FVector2D(Radius, Radius));
+		const FIntPoint MaxCell = ToCell(Center + FVector2D(Radius, Radius));
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+			{
+				Entries.Add({ FIntPoint(X, Y), ZoneIndex });
+			}
+		}
+	}
+
+	// Group by cell into one flat array
+	Entries.Sort([](const FEntry& A, const FEntry& B)
+	{
+		return A.Cell.X != B.Cell.X ? A.Cell.X < B.Cell.X : A.Cell.Y < B.Cell.Y;
+	});
+
+	CellZones.Reserve(Entries.Num());
+	for (int32 i = 0; i < Entries.Num(); ++i)
+	{
+		const FEntry& Entry = Entries[i];
+		if (i == 0 || Entry.Cell != Entries[i - 1].Cell)
+		{
+			CellLookup.Add(Entry.Cell, Cells.Num());
+			Cells.Add({ CellZones.Num(), 0 });
+		}
+		CellZones.Add(Entry.ZoneIndex);
+		Cells.Last().Num++;
+	}
+}
+
+void FAefZoneSpatialHash::Reset()
+{
+	Circles.Reset();
+	Cells.Reset();
+	CellZones.Reset();
+	CellLookup.Reset();
+}
@@ -0,0 +1,107 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Stream Capture
+
+   Records the raw receiver stream with arrival timestamps and reads it
+   back for replay. Captures of a show night can be replayed through the
+   normal receive path to reproduce bugs or test changes offline.
+========================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/** One received block of a capture (Data is valid until the next read) */
+struct FAefCaptureChunk
+{
+	/** Microseconds since the capture was started */
+	uint64 TimeMicros = 0;
+	const uint8* Data = nullptr;
+	int32 Num = 0;
+};
+
+/**
+ * Capture Writer
+ *
+ * File layout: magic "AEFC", version (uint32), then one chunk per socket
+ * read: TimeMicros (uint64), Size (uint32), Size bytes as received.
+ * Chunks are collected in a buffer and written in blocks, a crash loses
+ * at most the unflushed tail.
+ */
+class AEFDEEPSYNC_API FAefDeepSyncCaptureWriter
+{
+public:
+	FAefDeepSyncCaptureWriter() = default;
+	~FAefDeepSyncCaptureWriter();
+
+	/** Create (truncate) the capture file, the capture clock starts now */
+	bool Open(const FString& InPath);
+
+	/** Flush and close the file */
+	void Close();
+
+	bool IsOpen() const { return FileHandle.IsValid(); }
+
+	/** Append one received block */
+	void Write(const uint8* Data, int32 Num);
+
+	/** Bytes of received data written so far */
+	int64 GetCapturedBytes() const { return CapturedBytes; }
+
+	static constexpr uint32 FileMagic = 0x43464541;	// "AEFC"
+	static constexpr uint32 FileVersion = 1;
+	static constexpr int32 ChunkHeaderSize = 12;
+
+private:
+	static constexpr int32 FlushThreshold = 64 * 1024;
+
+	void Flush();
+
+	TUniquePtr<IFileHandle> FileHandle;
+	TArray<uint8> Buffer;
+	uint64 StartCycles = 0;
+	int64 CapturedBytes = 0;
+};
+
+/**
+ * Capture Reader
+ *
+ * Memory-maps the capture in windows of WindowSize bytes and moves the
+ * window along while reading, so multi-hour captures never load into RAM.
+ * Stops at the first truncated chunk (capture of a crashed session).
+ */
+class AEFDEEPSYNC_API FAefDeepSyncCaptureReader
+{
+public:
+	FAefDeepSyncCaptureReader() = default;
+	~FAefDeepSyncCaptureReader();
+
+	bool Open(const FString& InPath);
+	void Close();
+
+	bool IsOpen() const { return MappedFile.IsValid(); }
+
+	/** Read the next chunk, false at the end of the capture */
+	bool Next(FAefCaptureChunk& OutChunk);
+
+	/** Read position (0.0 to 1.0) */
+	float GetProgress() const;
+
+private:
+	static constexpr int64 WindowSize = 16 * 1024 * 1024;
+
+	/** Map a window that contains [Offset, Offset + Num) */
+	const uint8* MapRange(int64 Offset, int64 Num);
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> Window;
+	int64 WindowOffset = 0;
+	int64 WindowNum = 0;
+	int64 FileSize = 0;
+	int64 ReadOffset = 0;
+};
@@ -0,0 +1,71 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Command Encoder
+
+   Writes DeepSync JSON commands as UTF-8 bytes straight into a reusable
+   buffer. Commands are pure ASCII, integers are converted by hand, so
+   there is no Printf, no TCHAR string and no transcoding per command.
+   After the buffer has grown once, encoding does not allocate.
+
+   USAGE:
+   Encoder.Reset();
+   Encoder.AppendColorCommand(WearableId, Color);
+   Socket->Send(Encoder.GetData(), Encoder.Num(), BytesSent);
+========================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AefDeepSyncTypes.h"
+
+/**
+ * Command Encoder
+ *
+ * Several commands may be appended to one buffer, each ends with the
+ * 'X' delimiter the server splits on.
+ */
+class AEFDEEPSYNC_API FAefDeepSyncCommandEncoder
+{
+public:
+	/** Drop the encoded bytes, the capacity is kept */
+	void Reset() { Buffer.Reset(); }
+
+	/** Start color commands with "type":"color" like every other command (duplex connection) */
+	void SetTypeTags(bool bInTypeTags) { bTypeTags = bInTypeTags; }
+
+	/** {"Id":1,"Color":{"R":255,"G":0,"B":0}}X */
+	void AppendColorCommand(int32 WearableId, const FAefDeepSyncColor& Color);
+
+	/** {"Ids":[1,2,3],"Color":{"R":255,"G":0,"B":0}}X */
+	void AppendGroupColorCommand(TConstArrayView<int32> WearableIds, const FAefDeepSyncColor& Color);
+
+	/** {"type":"id","Id":1,"NewId":2}X */
+	void AppendIdCommand(int32 WearableId, int32 NewId);
+
+	/** {"type":"ping","Seq":1}X */
+	void AppendPingCommand(int32 Seq);
+
+	const uint8* GetData() const { return Buffer.GetData(); }
+	int32 Num() const { return Buffer.Num(); }
+
+	/** Buffer capacity in bytes (inline storage included) */
+	SIZE_T GetAllocatedSize() const { return Buffer.GetAllocatedSize(); }
+
+	/** Encoded bytes as a string, for logging */
+	FString ToString() const;
+
+private:
+	template <int32 N>
+	void AppendLiteral(const ANSICHAR (&Literal)[N])
+	{
+		Buffer.Append(reinterpret_cast<const uint8*>(Literal), N - 1);
+	}
+
+	void AppendInt(int32 Value);
+	void AppendColor(const FAefDeepSyncColor& Color);
+
+	/** Sized for a group command to a few hundred wearables without growing */
+	TArray<uint8, TInlineAllocator<4096>> Buffer;
+	bool bTypeTags = false;
+};
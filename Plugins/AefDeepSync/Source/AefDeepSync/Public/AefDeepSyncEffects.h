@@ -0,0 +1,99 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - LED Effects
+
+   Effect descriptions for the subsystem's LED effect sequencer. Effects
+   are evaluated at a fixed command rate and only changed 8-bit colors
+   are sent, or the whole description is uploaded to the server.
+
+   USAGE:
+   Subsystem->PlayLedEffect(WearableId, Effect);
+   Subsystem->StopLedEffect(WearableId);
+========================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AefDeepSyncTypes.h"
+#include "AefDeepSyncEffects.generated.h"
+
+/**
+ * LED Effect Type
+ */
+UENUM(BlueprintType)
+enum class EAefLedEffectType : uint8
+{
+	/** Set ToColor once */
+	Solid			UMETA(DisplayName = "Solid"),
+
+	/** Blend FromColor to ToColor over Duration, then stay */
+	Fade			UMETA(DisplayName = "Fade"),
+
+	/** Smooth FromColor -> ToColor -> FromColor cycle, Duration per cycle */
+	Pulse			UMETA(DisplayName = "Pulse"),
+
+	/** Flash ToColor on every heart beat and decay to FromColor (Duration = beat period without heart rate) */
+	HeartRatePulse	UMETA(DisplayName = "Heart Rate Pulse")
+};
+
+/**
+ * LED Effect
+ */
+USTRUCT(BlueprintType)
+struct AEFDEEPSYNC_API FAefLedEffect
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AEF|DeepSync|Effects")
+	EAefLedEffectType Type = EAefLedEffectType::Pulse;
+
+	/** Start / base color */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AEF|DeepSync|Effects")
+	FLinearColor FromColor = FLinearColor::Black;
+
+	/** End / peak color */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AEF|DeepSync|Effects")
+	FLinearColor ToColor = FLinearColor::White;
+
+	/** Fade time or cycle period in seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AEF|DeepSync|Effects", meta = (ClampMin = "0.01"))
+	float Duration = 1.0f;
+
+	/** Cycles or beats until the effect ends on FromColor (0 = until stopped) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AEF|DeepSync|Effects", meta = (ClampMin = "0"))
+	int32 Repeat = 0;
+
+	/** Name used in uploaded effect commands */
+	const ANSICHAR* GetTypeName() const;
+};
+
+/**
+ * Running LED Effect
+ *
+ * Time and beat phase of one playing effect. The beat phase accumulates
+ * with the current heart rate, so heart rate changes don't make the
+ * pulse jump.
+ */
+struct AEFDEEPSYNC_API FAefLedEffectState
+{
+	FAefLedEffect Effect;
+	double StartTime = 0.0;
+	double LastStepTime = 0.0;
+	float BeatPhase = 0.0f;
+
+	/** Last color sent for this effect (quantized) */
+	FAefDeepSyncColor LastSent;
+	bool bHasSent = false;
+
+	/** Effect was uploaded to the server, nothing is streamed */
+	bool bUploaded = false;
+
+	/** Effect has run out, removed once its final color is sent */
+	bool bFinished = false;
+
+	void Start(const FAefLedEffect& InEffect, double Now);
+
+	/** Advance to Now and return the color, bOutFinished once the effect has run out */
+	FAefDeepSyncColor Step(double Now, int32 HeartRate, bool& bOutFinished);
+};
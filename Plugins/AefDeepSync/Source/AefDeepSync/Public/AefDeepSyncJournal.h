@@ -0,0 +1,133 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Warm-Start Journal
+
+   Append-only binary journal of sync links and wearable snapshots.
+   Written through a plain file handle by a background thread, replayed
+   (memory-mapped) on startup so links survive a crash or restart of the
+   game instance.
+========================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+
+class FRunnableThread;
+class FEvent;
+class IFileHandle;
+
+/** Link as stored in the journal (zone referenced by its WearableId) */
+struct FAefJournalLink
+{
+	int32 LinkId = -1;
+	int32 WearableId = -1;
+	int32 PharusTrackID = -1;
+	int32 ZoneWearableId = -1;
+	FVector3f LastPharusPosition = FVector3f::ZeroVector;
+	FLinearColor ZoneColor = FLinearColor::Green;
+	int64 SyncTimeTicks = 0;
+};
+
+/** Subsystem state rebuilt from a journal */
+struct FAefJournalState
+{
+	int32 NextUniqueId = 0;
+	int32 NextLinkId = 0;
+
+	/** WearableId -> UniqueId of the last snapshot */
+	TMap<int32, int32> WearableUniqueIds;
+
+	/** LinkId -> link, links that were not broken */
+	TMap<int32, FAefJournalLink> Links;
+};
+
+/**
+ * Warm-Start Journal
+ *
+ * Record layout: Type (uint8), Version (uint8), PayloadSize (uint16),
+ * payload CRC32 (uint32), payload. Replay stops at the first torn or
+ * corrupt record, so a crash mid-write only loses the last record.
+ *
+ * All Write calls only serialize into a queue, file IO happens on the
+ * writer thread. The game thread never waits on disk except in Close().
+ */
+class AEFDEEPSYNC_API FAefDeepSyncJournal : public FRunnable
+{
+public:
+	FAefDeepSyncJournal() = default;
+	virtual ~FAefDeepSyncJournal() override;
+
+	/** Create (truncate) the journal file and start the writer thread */
+	bool Open(const FString& InPath);
+
+	/** Write pending records and stop the writer thread */
+	void Close();
+
+	bool IsOpen() const { return Thread != nullptr; }
+
+	/** Bytes queued since the last compaction (journal size estimate) */
+	int64 GetBytesSinceCompaction() const { return BytesSinceCompaction; }
+
+	//--------------------------------------------------------------------------------
+	// Records (game thread)
+	//--------------------------------------------------------------------------------
+
+	/** Link established or changed (restore, track handoff) */
+	void WriteLink(const FAefJournalLink& Link);
+
+	/** Link broken for good */
+	void WriteLinkBroken(int32 LinkId);
+
+	/** Id counters and UniqueIds of active wearables */
+	void WriteSnapshot(int32 NextUniqueId, int32 NextLinkId, const TMap<int32, int32>& WearableUniqueIds);
+
+	/** Start a compaction: the writer truncates the file, following records form the new journal */
+	void BeginCompaction();
+
+	//--------------------------------------------------------------------------------
+	// Replay
+	//--------------------------------------------------------------------------------
+
+	/** Read a journal file (memory-mapped if the platform supports it) */
+	static bool Replay(const FString& InPath, FAefJournalState& OutState);
+
+	//--------------------------------------------------------------------------------
+	// FRunnable Interface
+	//--------------------------------------------------------------------------------
+
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	enum class ERecordType : uint8
+	{
+		Link = 1,
+		LinkBroken = 2,
+		Snapshot = 3
+	};
+
+	struct FPendingWrite
+	{
+		TArray<uint8> Data;
+		bool bTruncate = false;
+	};
+
+	static constexpr uint32 FileMagic = 0x4A464541;	// "AEFJ"
+	static constexpr uint8 RecordVersion = 1;
+	static constexpr int32 RecordHeaderSize = 8;
+
+	void Enqueue(ERecordType Type, TArray<uint8>&& Payload);
+	void DrainQueue();
+	static bool ReadRecords(const uint8* Data, int64 Size, FAefJournalState& OutState);
+
+	FString Path;
+	TUniquePtr<IFileHandle> FileHandle;
+	TQueue<FPendingWrite, EQueueMode::Spsc> Queue;
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	TAtomic<bool> bStopping { false };
+	int64 BytesSinceCompaction = 0;
+};
@@ -0,0 +1,120 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Latency
+
+   Server clock estimation and latency histograms. Relates the server's
+   32-bit millisecond timestamps to the local clock so the age of
+   wearable data can be measured on arrival.
+========================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Latency Histogram
+ *
+ * Fixed buckets, no allocation after construction: 1 ms buckets up to
+ * LinearRangeMs, CoarseBucketMs buckets up to MaxRangeMs, and one
+ * overflow bucket. Percentiles are accurate to the bucket width.
+ */
+class AEFDEEPSYNC_API FAefLatencyHistogram
+{
+public:
+	static constexpr int32 LinearRangeMs = 256;
+	static constexpr int32 CoarseBucketMs = 16;
+	static constexpr int32 MaxRangeMs = 4096;
+	static constexpr int32 NumBuckets = LinearRangeMs + (MaxRangeMs - LinearRangeMs) / CoarseBucketMs + 1;
+
+	void Add(double LatencyMs);
+	void Append(const FAefLatencyHistogram& Other);
+	void Reset();
+
+	/** Latency below which Percentile (0..1) of the samples fall */
+	double GetPercentile(double Percentile) const;
+
+	int64 GetCount() const { return Count; }
+	double GetMean() const { return Count > 0 ? Sum / Count : 0.0; }
+	double GetMax() const { return Max; }
+
+private:
+	static int32 GetBucket(double LatencyMs);
+
+	uint32 Buckets[NumBuckets] = {};
+	int64 Count = 0;
+	double Sum = 0.0;
+	double Max = 0.0;
+};
+
+/**
+ * Server Clock Estimator
+ *
+ * Unwraps the server's int32 millisecond timestamps to a 64-bit timeline
+ * and estimates the offset between server and local clock.
+ *
+ * Every message gives one offset sample (local arrival - server time).
+ * Network and queueing delays only ever add to it, so the minimum per
+ * window is the best estimate. A line fitted through the window minima
+ * and lowered below all of them gives offset and drift. Latency of a
+ * message is its offset sample minus the estimate, i.e. the delay above
+ * the fastest path seen. The constant part of the network delay cannot
+ * be seen from one-way timestamps.
+ */
+class AEFDEEPSYNC_API FAefServerClock
+{
+public:
+	/** Seconds per min-filter window and number of windows in the fit */
+	void Configure(double InWindowSeconds, int32 InNumWindows);
+
+	/**
+	 * Widen a raw server timestamp to the 64-bit timeline.
+	 * Returns false if the server clock jumped back (server restart), the
+	 * offset estimate is reset then.
+	 */
+	bool Unwrap(int32 RawTimestamp, int64& OutServerTime);
+
+	/** Add an arrival, returns the latency in ms (0 until an estimate exists) */
+	double AddSample(int64 ServerTime, double LocalMs);
+
+	bool HasEstimate() const { return bHasEstimate; }
+
+	/** Local minus server clock in ms at the given local time */
+	double GetOffsetMs(double LocalMs) const;
+
+	/** Server clock drift relative to the local clock in ppm */
+	double GetDriftPpm() const { return Slope * 1.0e6; }
+
+	void Reset();
+	void ResetEstimate();
+
+private:
+	struct FWindow
+	{
+		double LocalMs = 0.0;
+		double MinOffsetMs = 0.0;
+	};
+
+	void CloseWindow();
+	void Fit();
+
+	/** Jumps back by more than this are a server restart, smaller ones are reordering */
+	static constexpr int32 RestartThresholdMs = 10000;
+
+	double WindowMs = 10000.0;
+	int32 NumWindows = 30;
+
+	bool bHasRaw = false;
+	int32 LastRaw = 0;
+	int64 LastServerTime = 0;
+
+	TArray<FWindow> Windows;
+	FWindow Current;
+	double CurrentStartMs = 0.0;
+	bool bCurrentValid = false;
+
+	bool bHasEstimate = false;
+	double OriginMs = 0.0;
+	double Intercept = 0.0;
+	double Slope = 0.0;
+};
@@ -69,6 +69,14 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "AEF|DeepSync|Sync Events")
 	FAefOnLinkBroken OnLinkBroken;
 
+	/** Fired when a lost sync link is restored within the grace window */
+	UPROPERTY(BlueprintAssignable, Category = "AEF|DeepSync|Sync Events")
+	FAefOnLinkRestored OnLinkRestored;
+
+	/** Fired when a sync link follows its person to a new Pharus TrackID */
+	UPROPERTY(BlueprintAssignable, Category = "AEF|DeepSync|Sync Events")
+	FAefOnLinkTrackReassigned OnLinkTrackReassigned;
+
 	/** Fired when a zone is registered with the subsystem */
 	UPROPERTY(BlueprintAssignable, Category = "AEF|DeepSync|Sync Events")
 	FAefOnZoneRegistered OnZoneRegistered;
@@ -144,6 +152,12 @@ private:
 	UFUNCTION()
 	void HandleLinkBroken(const FAefSyncedLink& Link, const FString& Reason);
 
+	UFUNCTION()
+	void HandleLinkRestored(const FAefSyncedLink& Link);
+
+	UFUNCTION()
+	void HandleLinkTrackReassigned(const FAefSyncedLink& Link, int32 OldPharusTrackID);
+
 	UFUNCTION()
 	void HandleZoneRegistered(AAefPharusDeepSyncZoneActor* Zone);
 
@@ -0,0 +1,85 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Stats
+
+   Stat group and CSV profiler category of the plugin.
+
+   USAGE:
+   stat AefDeepSync                      (in-game stat overlay)
+   -csvCategories=AefDeepSync            (CSV profiler captures)
+========================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("AefDeepSync"), STATGROUP_AefDeepSync, STATCAT_Advanced);
+
+//--------------------------------------------------------------------------------
+// Cycle Counters
+//--------------------------------------------------------------------------------
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Subsystem Tick"), STAT_AefDeepSync_Tick, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Receive"), STAT_AefDeepSync_Receive, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse"), STAT_AefDeepSync_Parse, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dispatch"), STAT_AefDeepSync_Dispatch, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Wearable Timeouts"), STAT_AefDeepSync_WearableTimeouts, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Link Maintenance"), STAT_AefDeepSync_LinkMaintenance, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Zone Sync"), STAT_AefDeepSync_ZoneSync, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Zone Detection"), STAT_AefDeepSync_ZoneDetection, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Zone Assignment"), STAT_AefDeepSync_ZoneAssignment, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Zone Overlap"), STAT_AefDeepSync_ZoneOverlap, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Journal"), STAT_AefDeepSync_Journal, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Send Command"), STAT_AefDeepSync_SendCommand, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("LED Effects"), STAT_AefDeepSync_LedEffects, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Component"), STAT_AefDeepSync_Component, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Manager Forward"), STAT_AefDeepSync_ManagerForward, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+
+//--------------------------------------------------------------------------------
+// Per-Frame Counters (reset every frame)
+//--------------------------------------------------------------------------------
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Messages"), STAT_AefDeepSync_Messages, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Received"), STAT_AefDeepSync_BytesReceived, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Commands Sent"), STAT_AefDeepSync_CommandsSent, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Color Reconcile Commands"), STAT_AefDeepSync_ColorReconcileCommands, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("LED Effect Commands"), STAT_AefDeepSync_LedEffectCommands, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+
+//--------------------------------------------------------------------------------
+// State (kept across frames)
+//--------------------------------------------------------------------------------
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Parse Failures"), STAT_AefDeepSync_ParseFailures, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Receive Backlog (chars)"), STAT_AefDeepSync_ReceiveBacklog, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Send Backlog (bytes)"), STAT_AefDeepSync_SendBacklog, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Wearables"), STAT_AefDeepSync_ActiveWearables, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Links"), STAT_AefDeepSync_Links, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Relinks"), STAT_AefDeepSync_PendingRelinks, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Zones Syncing"), STAT_AefDeepSync_ZonesSyncing, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Color Targets Pending"), STAT_AefDeepSync_ColorTargetsPending, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("LED Effects Playing"), STAT_AefDeepSync_LedEffectsPlaying, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Oldest Wearable Data (s)"), STAT_AefDeepSync_OldestWearableData, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Latency p50 (ms)"), STAT_AefDeepSync_LatencyP50, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Latency p95 (ms)"), STAT_AefDeepSync_LatencyP95, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Latency p99 (ms)"), STAT_AefDeepSync_LatencyP99, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Server Clock Drift (ppm)"), STAT_AefDeepSync_ClockDrift, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Color Command p95 (ms)"), STAT_AefDeepSync_ColorCommandP95, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Unconfirmed Color Commands"), STAT_AefDeepSync_UnconfirmedColorCommands, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Color Commands"), STAT_AefDeepSync_PendingColorCommands, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Command Queue Critical"), STAT_AefDeepSync_CommandQueueCritical, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Command Queue Normal"), STAT_AefDeepSync_CommandQueueNormal, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Command Queue Background"), STAT_AefDeepSync_CommandQueueBackground, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Command Wait p95 Critical (ms)"), STAT_AefDeepSync_CommandWaitCritical, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Command Wait p95 Normal (ms)"), STAT_AefDeepSync_CommandWaitNormal, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Command Wait p95 Background (ms)"), STAT_AefDeepSync_CommandWaitBackground, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Heartbeat RTT (ms)"), STAT_AefDeepSync_HeartbeatRtt, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Time Since Receive (s)"), STAT_AefDeepSync_TimeSinceReceive, STATGROUP_AefDeepSync, AEFDEEPSYNC_API);
+
+//--------------------------------------------------------------------------------
+// CSV Profiler
+//--------------------------------------------------------------------------------
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(AEFDEEPSYNC_API, AefDeepSync);
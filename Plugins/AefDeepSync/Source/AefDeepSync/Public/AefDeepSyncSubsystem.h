@@ -20,8 +20,16 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Tickable.h"
+#include "Engine/EngineTypes.h"
 #include "AefDeepSyncTypes.h"
 #include "AefPharusSyncTypes.h"
+#include "AefZoneSpatialHash.h"
+#include "AefZoneAssignmentSolver.h"
+#include "AefDeepSyncJournal.h"
+#include "AefDeepSyncCapture.h"
+#include "AefDeepSyncLatency.h"
+#include "AefDeepSyncEffects.h"
+#include "AefDeepSyncCommandEncoder.h"
 #include "AefDeepSyncSubsystem.generated.h"
 
 class FSocket;
@@ -35,6 +43,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAefOnWearableConnected, const FAefD
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAefOnWearableLost, const FAefDeepSyncWearableData&, WearableData);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAefOnWearableUpdated, int32, WearableId, const FAefDeepSyncWearableData&, WearableData);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAefOnConnectionStatusChanged, EAefDeepSyncConnectionStatus, Status);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAefOnConnectionHealthChanged, bool, bDegraded, float, HeartbeatRttMs);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FAefOnIdProvisioned, int32, OldId, int32, NewId, bool, bSuccess);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAefOnIdProvisioningFinished, int32, Succeeded, int32, Failed);
 
 /**
  * DeepSync Wearable Subsystem
@@ -88,6 +99,49 @@ public:
 	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync")
 	bool IsRunning() const;
 
+	/** Smoothed heartbeat round trip in ms (-1 until a pong arrived, needs heartbeat=true) */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync")
+	float GetHeartbeatRttMs() const { return HeartbeatRttMs; }
+
+	/** Seconds since bytes were last received on the connection (0 when not connected) */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync")
+	float GetTimeSinceLastReceive() const;
+
+	/** Connected, but silent for more than half of heartbeatTimeout (needs heartbeat=true and a server that answers pings) */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync")
+	bool IsConnectionDegraded() const { return bConnectionDegraded; }
+
+	//--------------------------------------------------------------------------------
+	// Capture & Replay
+	//--------------------------------------------------------------------------------
+
+	/** Record the received stream to a capture file (empty path = Saved/AefDeepSync/DeepSync_<time>.capture) */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Capture")
+	bool StartCapture(const FString& FilePath);
+
+	/** Stop recording and close the capture file */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Capture")
+	void StopCapture();
+
+	/** Check if the received stream is being recorded */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Capture")
+	bool IsCapturing() const { return CaptureWriter.IsOpen(); }
+
+	/**
+	 * Replay a capture instead of connecting to the server (DeepSync must be stopped).
+	 * Data runs through the normal receive path, Speed scales the original timing.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Capture")
+	bool StartReplay(const FString& FilePath, float Speed = 1.0f);
+
+	/** Check if a capture is being replayed */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Capture")
+	bool IsReplaying() const { return bReplaying; }
+
+	/** Replay position (0.0 to 1.0) */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Capture")
+	float GetReplayProgress() const { return bReplaying ? ReplayReader.GetProgress() : 0.0f; }
+
 	//--------------------------------------------------------------------------------
 	// Wearable Access
 	//--------------------------------------------------------------------------------
@@ -108,6 +162,50 @@ public:
 	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Wearables")
 	bool IsWearableActive(int32 WearableId) const { return ActiveWearables.Contains(WearableId); }
 
+	//--------------------------------------------------------------------------------
+	// Latency
+	//--------------------------------------------------------------------------------
+
+	/** Latency over all wearables since start or the last reset (needs measureLatency) */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Latency")
+	FAefDeepSyncLatencyStats GetLatencyStats() const;
+
+	/** Latency of one active wearable, false if it has no samples (dropped when the wearable is lost) */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Latency")
+	bool GetWearableLatencyStats(int32 WearableId, FAefDeepSyncLatencyStats& OutStats) const;
+
+	/** Estimated local minus server clock in ms (includes the constant part of the network delay) */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Latency")
+	double GetServerClockOffsetMs() const;
+
+	/** Estimated drift of the server clock against the local clock in ppm */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Latency")
+	float GetServerClockDriftPpm() const { return static_cast<float>(ServerClock.GetDriftPpm()); }
+
+	/** Check if the server clock offset has been estimated (after the first window) */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Latency")
+	bool HasServerClockEstimate() const { return ServerClock.HasEstimate(); }
+
+	/** Clear all latency histograms */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Latency")
+	void ResetLatencyStats();
+
+	/** Time from SendColorCommand until the wearable reports the color, rolling window (needs probeColorCommands) */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Latency")
+	FAefDeepSyncLatencyStats GetColorCommandLatencyStats() const;
+
+	/** Color commands the wearable never reported within colorProbeTimeout */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Latency")
+	int64 GetUnconfirmedColorCommandCount() const { return ColorProbesUnconfirmed; }
+
+	/** Color commands waiting for the wearable to report them */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Latency")
+	int32 GetPendingColorCommandCount() const;
+
+	/** Clear the color command histogram and counters */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Latency")
+	void ResetColorCommandLatencyStats();
+
 	//--------------------------------------------------------------------------------
 	// Commands
 	//--------------------------------------------------------------------------------
@@ -119,10 +217,138 @@ public:
 	/** Send color command to wearable (internal struct) */
 	bool SendColorCommand(int32 WearableId, FAefDeepSyncColor InColor);
 
+	/** Send one color to several wearables in a single write */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Commands", meta = (DisplayName = "Send Color Command (Multiple)"))
+	bool SendColorCommandToWearables(const TArray<int32>& WearableIds, FLinearColor InColor);
+
+	/** Send one color to all active wearables in a single write */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Commands", meta = (DisplayName = "Send Color Command (All)"))
+	bool SendColorCommandToAll(FLinearColor InColor);
+
+	/** Send one color to a group from the colorGroups config in a single write */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Commands", meta = (DisplayName = "Send Color Command (Group)"))
+	bool SendColorCommandToGroup(FName GroupName, FLinearColor InColor);
+
+	/** Send one color to several wearables (internal struct) */
+	bool SendColorCommandToIds(TConstArrayView<int32> WearableIds, FAefDeepSyncColor InColor);
+
+	/** Names of the groups from the colorGroups config */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Commands")
+	TArray<FName> GetColorGroupNames() const;
+
+	/** WearableIds of a group from the colorGroups config (empty if unknown) */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Commands")
+	TArray<int32> GetColorGroup(FName GroupName) const;
+
 	/** Send ID change command to wearable */
 	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Commands", meta = (DisplayName = "Send ID Command"))
 	bool SendIdCommand(int32 WearableId, int32 NewId);
 
+	//--------------------------------------------------------------------------------
+	// Command Lanes
+	//--------------------------------------------------------------------------------
+
+	/**
+	 * Send a color command in a priority lane (commandLanes=true), e.g. Critical for
+	 * an exit color that must not wait behind animations. Without lanes it is sent
+	 * right away like SendColorCommand.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Commands", meta = (DisplayName = "Send Color Command (Priority)"))
+	bool SendColorCommandWithPriority(int32 WearableId, FLinearColor InColor, EAefCommandPriority Priority);
+
+	/** Commands waiting in a lane */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Commands")
+	int32 GetCommandQueueDepth(EAefCommandPriority Priority) const;
+
+	/** Time commands of a lane waited before they were written */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Commands")
+	FAefDeepSyncLatencyStats GetCommandWaitStats(EAefCommandPriority Priority) const;
+
+	/** Clear the wait histograms of all lanes */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Commands")
+	void ResetCommandWaitStats();
+
+	//--------------------------------------------------------------------------------
+	// Color Reconciliation
+	//--------------------------------------------------------------------------------
+
+	/**
+	 * Set the color a wearable should show. Commands are only sent while the
+	 * reported color differs, retried with backoff until the wearable reports it.
+	 * Safe to call every frame, an unchanged target sends nothing.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Commands")
+	void SetTargetColor(int32 WearableId, FLinearColor InColor);
+
+	/** Stop reconciling a wearable (its LED keeps the current color) */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Commands")
+	void ClearTargetColor(int32 WearableId);
+
+	/** Stop reconciling all wearables */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Commands")
+	void ClearAllTargetColors();
+
+	/** Get the target color of a wearable, false if it has none */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Commands")
+	bool GetTargetColor(int32 WearableId, FLinearColor& OutColor) const;
+
+	/** Check if a wearable reports its target color */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Commands")
+	bool IsTargetColorReached(int32 WearableId) const;
+
+	/** Number of wearables with a target color they don't report yet */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Commands")
+	int32 GetPendingTargetColorCount() const;
+
+	//--------------------------------------------------------------------------------
+	// LED Effects
+	//--------------------------------------------------------------------------------
+
+	/**
+	 * Play an LED effect on a wearable (replaces a playing one). Evaluated at
+	 * effectCommandRate, a command is only sent when the 8-bit color changes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Effects")
+	void PlayLedEffect(int32 WearableId, const FAefLedEffect& Effect);
+
+	/** Stop the effect of a wearable (its LED keeps the current color) */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Effects")
+	void StopLedEffect(int32 WearableId);
+
+	/** Stop all playing effects */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Effects")
+	void StopAllLedEffects();
+
+	/** Check if a wearable plays an effect */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Effects")
+	bool IsLedEffectPlaying(int32 WearableId) const { return LedEffects.Contains(WearableId); }
+
+	//--------------------------------------------------------------------------------
+	// ID Provisioning
+	//--------------------------------------------------------------------------------
+
+	/**
+	 * Re-ID many wearables (OldId -> NewId). Up to idProvisioningInFlight commands
+	 * wait for confirmation at once: the new ID shows up in the stream and the old
+	 * one goes silent. Unconfirmed changes are retried, every result fires
+	 * OnIdProvisioned. Returns false if a job is running or the mapping is invalid
+	 * (new ID in use, appears twice, or is also an old ID).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Commands", meta = (DisplayName = "Start ID Provisioning"))
+	bool StartIdProvisioning(const TMap<int32, int32>& OldToNewIds);
+
+	/** Stop the running job, unconfirmed changes are not reported */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Commands", meta = (DisplayName = "Cancel ID Provisioning"))
+	void CancelIdProvisioning();
+
+	/** Check if a provisioning job is running */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Commands", meta = (DisplayName = "Is ID Provisioning"))
+	bool IsIdProvisioning() const { return IdJobs.Num() > 0; }
+
+	/** Progress of the running job (all 0 if none) */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Commands", meta = (DisplayName = "Get ID Provisioning Progress"))
+	void GetIdProvisioningProgress(int32& OutSucceeded, int32& OutFailed, int32& OutTotal) const;
+
 	//--------------------------------------------------------------------------------
 	// Events
 	//--------------------------------------------------------------------------------
@@ -143,6 +369,18 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "AEF|DeepSync|Events")
 	FAefOnConnectionStatusChanged OnConnectionStatusChanged;
 
+	/** Fired when a connected link goes quiet (degraded) or recovers, with the heartbeat round trip */
+	UPROPERTY(BlueprintAssignable, Category = "AEF|DeepSync|Events")
+	FAefOnConnectionHealthChanged OnConnectionHealthChanged;
+
+	/** Fired when an ID change of a provisioning job is confirmed or has failed */
+	UPROPERTY(BlueprintAssignable, Category = "AEF|DeepSync|Events")
+	FAefOnIdProvisioned OnIdProvisioned;
+
+	/** Fired when every ID change of a provisioning job has a result */
+	UPROPERTY(BlueprintAssignable, Category = "AEF|DeepSync|Events")
+	FAefOnIdProvisioningFinished OnIdProvisioningFinished;
+
 	//--------------------------------------------------------------------------------
 	// Configuration
 	//--------------------------------------------------------------------------------
@@ -156,6 +394,9 @@ public:
 	void ReloadConfiguration();
 
 private:
+	/** Pipeline benchmarks drive the receive, maintenance and zone paths directly */
+	friend class FAefDeepSyncBenchmarks;
+
 	//--------------------------------------------------------------------------------
 	// Configuration
 	//--------------------------------------------------------------------------------
@@ -168,9 +409,15 @@ private:
 	//--------------------------------------------------------------------------------
 
 	FSocket* ReceiverSocket = nullptr;
+
+	/** Same socket as ReceiverSocket on a duplex connection */
 	FSocket* SenderSocket = nullptr;
 	FString ReceiveBuffer;
 
+	/** Per-frame receive counters for the CSV profiler, reset in PublishFrameStats */
+	int32 FrameMessageCount = 0;
+	int32 FrameBytesReceived = 0;
+
 	EAefDeepSyncConnectionStatus ConnectionStatus = EAefDeepSyncConnectionStatus::Disconnected;
 	float ReconnectTimer = 0.0f;
 	float CurrentReconnectDelay = 2.0f;
@@ -181,10 +428,63 @@ private:
 
 	bool ConnectToServer();
 	void DisconnectFromServer();
+
+	/** Connect a non-blocking TCP socket, nullptr on failure (logged with Name) */
+	FSocket* OpenConnection(const TCHAR* Name, int32 Port);
 	void ProcessReceivedData();
+
+	/** Frame and dispatch received bytes, ArrivalMs is the local receive time (capture time during replay) */
+	void ConsumeReceivedBytes(const uint8* Data, int32 Num, double ArrivalMs);
 	bool ParseWearableMessage(const FString& JsonMessage, FAefDeepSyncWearableData& OutData);
+
+	/** Server message other than wearable data ({"type":"..."}, duplex connection or heartbeat pong) */
+	void HandleControlMessage(const FString& JsonMessage);
 	void SetConnectionStatus(EAefDeepSyncConnectionStatus NewStatus);
 
+	/** Push the gauge stats (wearables, links, backlog) at the end of each tick */
+	void PublishFrameStats();
+
+	//--------------------------------------------------------------------------------
+	// Heartbeat (Internal)
+	//--------------------------------------------------------------------------------
+
+	/** Last time bytes arrived, 0 until the first heartbeat tick of a connection */
+	double LastReceiveTime = 0.0;
+	float HeartbeatTimer = 0.0f;
+	int32 NextPingSeq = 0;
+
+	/** Send time per outstanding ping, indexed by Seq % NumPingSlots (0 = answered or lost) */
+	static constexpr int32 NumPingSlots = 16;
+	double PingSendTimes[NumPingSlots] = {};
+
+	float HeartbeatRttMs = -1.0f;
+
+	/** The server answered a ping on this connection, only then silence drops it */
+	bool bHeartbeatArmed = false;
+
+	bool bConnectionDegraded = false;
+
+	/** Send pings and, once a pong arrived, drop the connection when nothing was received for HeartbeatTimeout */
+	void TickHeartbeat(float DeltaTime);
+	void HandlePong(int32 Seq);
+	void ResetHeartbeat();
+
+	//--------------------------------------------------------------------------------
+	// Capture & Replay (Internal)
+	//--------------------------------------------------------------------------------
+
+	FAefDeepSyncCaptureWriter CaptureWriter;
+	FAefDeepSyncCaptureReader ReplayReader;
+
+	/** Next chunk of the replay, consumed once the replay clock reaches it */
+	FAefCaptureChunk PendingReplayChunk;
+	bool bHasPendingReplayChunk = false;
+	bool bReplaying = false;
+	double ReplayClockMicros = 0.0;
+	float ReplaySpeed = 1.0f;
+
+	void ProcessReplayData(float DeltaTime);
+
 	//--------------------------------------------------------------------------------
 	// Wearable Management
 	//--------------------------------------------------------------------------------
@@ -196,6 +496,207 @@ private:
 	void CheckWearableTimeouts(float DeltaTime);
 	bool IsWearableIdAllowed(int32 WearableId) const;
 
+	//--------------------------------------------------------------------------------
+	// Command Sending (Internal)
+	//--------------------------------------------------------------------------------
+
+	/** Check sender socket and connection, logs why not */
+	bool CanSendCommand() const;
+
+	/**
+	 * Write encoded commands without blocking. What the socket does not take is
+	 * kept in SendBuffer and written from Tick. False if the connection is broken.
+	 */
+	bool SendCommandBytes(const uint8* Data, int32 Num, int32& OutBytesSent);
+
+	/** Write as much of SendBuffer as the socket takes */
+	void FlushSendBuffer();
+
+	/** Non-blocking write, returns the bytes written, sets bSendFailed on a socket error */
+	int32 WriteToSenderSocket(const uint8* Data, int32 Num);
+
+	/** Unsent tail of earlier commands, written before any new command */
+	TArray<uint8> SendBuffer;
+
+	/** Socket error on the command connection, Tick reconnects (not done inline, callers may be iterating) */
+	bool bSendFailed = false;
+
+	/** Commands the server has not taken yet before the connection counts as stuck */
+	static constexpr int32 MaxSendBacklog = 1024 * 1024;
+
+	/** Reused for every color and ID command, no allocation per command */
+	FAefDeepSyncCommandEncoder CommandEncoder;
+
+	//--------------------------------------------------------------------------------
+	// Command Lanes (Internal)
+	//--------------------------------------------------------------------------------
+
+	struct FAefQueuedCommand
+	{
+		/** Single target, ignored for group commands */
+		int32 WearableId = -1;
+
+		/** ID command if >= 0 */
+		int32 NewId = -1;
+
+		FAefDeepSyncColor Color;
+
+		/** Group color command targets (empty for single commands) */
+		TArray<int32> GroupIds;
+
+		double EnqueueTime = 0.0;
+	};
+
+	struct FAefCommandLane
+	{
+		/** FIFO, entries before Head are written */
+		TArray<FAefQueuedCommand> Queue;
+		int32 Head = 0;
+
+		/** Queued single color command per wearable (Background lane replaces instead of appending) */
+		TMap<int32, int32> QueuedColorIndex;
+
+		FAefLatencyHistogram WaitHistogram;
+
+		int32 Num() const { return Queue.Num() - Head; }
+	};
+
+	static constexpr int32 NumCommandLanes = 3;
+	FAefCommandLane CommandLanes[NumCommandLanes];
+
+	/** Lane command whose tail is still in SendBuffer, its wait ends when the socket takes it */
+	struct FAefPendingCommandWait
+	{
+		int32 Lane = 0;
+
+		/** Bytes of SendBuffer up to the end of the command */
+		int32 EndOffset = 0;
+
+		double EnqueueTime = 0.0;
+	};
+
+	TArray<FAefPendingCommandWait> PendingCommandWaits;
+
+	bool QueueCommand(EAefCommandPriority Priority, FAefQueuedCommand&& Command);
+
+	/** Write the lanes within their budgets, only once SendBuffer is drained */
+	void FlushCommandLanes();
+
+	/** Drop queued commands, the critical lane optionally survives for the next connection */
+	void ClearCommandLanes(bool bKeepCritical);
+
+	/** Wearable timeouts are held after a reconnect until data flows again (reconnect grace) */
+	bool bHoldWearableTimeouts = false;
+	float WearableTimeoutHoldTimer = 0.0f;
+
+	void BeginWearableTimeoutHold();
+	void ResumeWearableTimeouts(const TCHAR* Reason);
+
+	//--------------------------------------------------------------------------------
+	// Latency (Internal)
+	//--------------------------------------------------------------------------------
+
+	FAefServerClock ServerClock;
+	FAefLatencyHistogram LatencyHistogram;
+	TMap<int32, FAefLatencyHistogram> WearableLatencyHistograms;
+
+	/** Widen the timestamp and, with measureLatency, measure the message against its arrival */
+	void MeasureLatency(FAefDeepSyncWearableData& Data, double ArrivalMs);
+	static FAefDeepSyncLatencyStats MakeLatencyStats(const FAefLatencyHistogram& Histogram);
+
+	/** Color command waiting for the wearable to report its color */
+	struct FAefColorProbe
+	{
+		FAefDeepSyncColor Color;
+		double SentTime = 0.0;
+	};
+
+	static constexpr int32 MaxColorProbesPerWearable = 16;
+
+	TMap<int32, TArray<FAefColorProbe, TInlineAllocator<4>>> ColorProbes;
+	FAefLatencyHistogram ColorProbeHistogram;
+	FAefLatencyHistogram PreviousColorProbeHistogram;
+	double ColorProbeWindowStart = 0.0;
+	int64 ColorProbesUnconfirmed = 0;
+
+	void AddColorProbe(int32 WearableId, const FAefDeepSyncColor& Color);
+	void ConfirmColorProbes(const FAefDeepSyncWearableData& Data);
+	void ExpireColorProbes();
+
+	//--------------------------------------------------------------------------------
+	// Color Reconciliation (Internal)
+	//--------------------------------------------------------------------------------
+
+	struct FAefColorTarget
+	{
+		FAefDeepSyncColor Color;
+		double NextSendTime = 0.0;
+		int32 Attempts = 0;
+		bool bReached = false;
+	};
+
+	TMap<int32, FAefColorTarget> ColorTargets;
+
+	/** Commands the reconciler may still send (token bucket, refilled at colorReconcileRate) */
+	float ColorReconcileBudget = 1.0f;
+
+	/** Position in ColorTargets where the next reconcile pass starts (round robin) */
+	int32 ColorReconcileCursor = 0;
+
+	void ReconcileColorTargets(float DeltaTime);
+	void UpdateColorTarget(const FAefDeepSyncWearableData& Data);
+	bool SendColorTarget(int32 WearableId, FAefColorTarget& Target, double Now);
+
+	//--------------------------------------------------------------------------------
+	// LED Effects (Internal)
+	//--------------------------------------------------------------------------------
+
+	TMap<int32, FAefLedEffectState> LedEffects;
+	float LedEffectStepTimer = 0.0f;
+
+	void TickLedEffects(float DeltaTime);
+
+	/** Send an effect description to the server (nullptr = stop) */
+	bool UploadLedEffect(int32 WearableId, const FAefLedEffect* Effect);
+
+	/** Send different colors to several wearables in one write */
+	bool SendColorCommandBatch(TConstArrayView<TPair<int32, FAefDeepSyncColor>> Commands);
+
+	//--------------------------------------------------------------------------------
+	// ID Provisioning (Internal)
+	//--------------------------------------------------------------------------------
+
+	enum class EAefIdJobState : uint8 { Queued, Sent, Succeeded, Failed };
+
+	struct FAefIdJob
+	{
+		int32 OldId = -1;
+		int32 NewId = -1;
+		EAefIdJobState State = EAefIdJobState::Queued;
+		int32 Attempts = 0;
+		double SentTime = 0.0;
+
+		/** First update with the new ID since the command (0 = not seen) */
+		double NewIdSeenTime = 0.0;
+	};
+
+	TArray<FAefIdJob> IdJobs;
+
+	/** Old and new IDs of the job -> index in IdJobs */
+	TMap<int32, int32> IdJobsByWearable;
+
+	int32 IdJobsNextQueued = 0;
+	int32 IdJobsInFlight = 0;
+	int32 IdJobsSucceeded = 0;
+	int32 IdJobsFailed = 0;
+
+	/** Disconnect time while jobs are paused (0 = running), timeouts are shifted by the pause */
+	double IdJobsPausedSince = 0.0;
+
+	void TickIdProvisioning();
+	void ObserveIdProvisioning(int32 WearableId);
+	void FinishIdJob(FAefIdJob& Job, bool bSuccess);
+
 	//--------------------------------------------------------------------------------
 	// Pharus Sync Zone Management (Internal)
 	//--------------------------------------------------------------------------------
@@ -205,7 +706,158 @@ private:
 	int32 NextLinkId = 0;
 
 	void CheckForBrokenLinks();
-	void BreakLinkInternal(int32 Index, const FString& Reason);
+	void BreakLinkInternal(int32 Index, const FString& Reason, bool bAllowRelink = false);
+
+	//--------------------------------------------------------------------------------
+	// Link Tombstones (Internal)
+	//--------------------------------------------------------------------------------
+
+	/** Lost link waiting for its wearable or a new track (still blocks zone and wearable) */
+	struct FAefLinkTombstone
+	{
+		FAefSyncedLink Link;
+		FString Reason;
+		float TimeRemaining = 0.0f;
+		double LostWorldTime = 0.0;
+	};
+
+	TArray<FAefLinkTombstone> LinkTombstones;
+
+	void UpdateLinkTombstones(float DeltaTime);
+	AActor* FindRelinkPharusActor(const FAefLinkTombstone& Tombstone) const;
+	void RestoreLink(int32 TombstoneIndex, AActor* PharusActor);
+	void ExpireLinkTombstone(int32 TombstoneIndex, const FString& Reason);
+	bool IsNewPharusActor(const AActor* Actor, double LostWorldTime) const;
+	bool IsPharusTrackSyncing(int32 TrackID) const;
+
+	//--------------------------------------------------------------------------------
+	// Warm-Start Journal (Internal)
+	//--------------------------------------------------------------------------------
+
+	FAefDeepSyncJournal Journal;
+
+	/** Links of the previous run, restored when wearable, zone and track come back */
+	TArray<FAefJournalLink> JournalPendingLinks;
+
+	/** UniqueIds of the previous run, reused when the wearable reconnects */
+	TMap<int32, int32> JournalUniqueIds;
+
+	/** End of the restore window, 0 until the first connect */
+	double JournalRestoreDeadline = 0.0;
+	float JournalSnapshotTimer = 0.0f;
+
+	/** Journal grows by snapshots, compact once it passes this size */
+	static constexpr int64 JournalCompactionBytes = 4 * 1024 * 1024;
+
+	void OpenJournal();
+	void UpdateJournal(float DeltaTime);
+	void RestoreJournalLinks();
+	void WriteJournalCheckpoint();
+	void WriteJournalSnapshot();
+	void JournalLink(const FAefSyncedLink& Link);
+	void JournalLinkBroken(const FAefSyncedLink& Link);
+
+	//--------------------------------------------------------------------------------
+	// Track Handoff (Internal)
+	//--------------------------------------------------------------------------------
+
+	/** Link whose Pharus actor vanished, waiting for the tracker's new TrackID (link stays active) */
+	struct FAefTrackHandoff
+	{
+		int32 LinkId = -1;
+		int32 OldTrackID = -1;
+		FVector LastPosition = FVector::ZeroVector;
+		double LostWorldTime = 0.0;
+		float TimeRemaining = 0.0f;
+	};
+
+	/** Candidate pair of a pending handoff and a new track */
+	struct FAefHandoffMatch
+	{
+		double DistSq = 0.0;
+		int32 HandoffIndex = -1;
+		AActor* Actor = nullptr;
+		int32 TrackID = -1;
+	};
+
+	TArray<FAefTrackHandoff> PendingHandoffs;
+	FAefZoneSpatialHash HandoffHash;
+	TArray<FVector2D> HandoffCenters;
+	TArray<float> HandoffRadii;
+	TArray<FAefHandoffMatch> HandoffMatches;
+
+	void UpdateTrackHandoffs(float DeltaTime);
+	bool IsHandoffPending(int32 LinkId) const;
+	int32 FindLinkIndex(int32 LinkId) const;
+
+	//--------------------------------------------------------------------------------
+	// Zone Sync Sessions (Internal)
+	//--------------------------------------------------------------------------------
+
+	/** Zone with tracks inside or a running sync. Empty zones are not stored and cost nothing. */
+	struct FAefZoneSyncSession
+	{
+		TWeakObjectPtr<AAefPharusDeepSyncZoneActor> Zone;
+	};
+
+	TArray<FAefZoneSyncSession> ZoneSyncSessions;
+	bool bIsTickingZoneSyncs = false;
+
+	void TickZoneSyncSessions(float DeltaTime);
+
+	//--------------------------------------------------------------------------------
+	// Pharus Track Registry (Internal)
+	//--------------------------------------------------------------------------------
+
+	/** Pharus actors in the world of the registered zones */
+	TArray<TWeakObjectPtr<AActor>> PharusActors;
+	TWeakObjectPtr<UWorld> PharusWorld;
+	FDelegateHandle ActorSpawnedHandle;
+
+	void TrackPharusActors(UWorld* World);
+	void StopTrackingPharusActors();
+
+	/** Re-apply the configured detection mode to registered zones (after ReloadConfiguration) */
+	void ApplyZoneDetectionMode();
+	void AddPharusActor(AActor* Actor);
+	void HandleActorSpawned(AActor* Actor);
+
+	UFUNCTION()
+	void HandlePharusActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	//--------------------------------------------------------------------------------
+	// Spatial Hash Zone Detection (Internal)
+	//--------------------------------------------------------------------------------
+
+	/** Track inside a zone this tick (Key = zone index << 32 | TrackID) */
+	struct FAefZoneOccupant
+	{
+		uint64 Key = 0;
+		AActor* Actor = nullptr;
+	};
+
+	FAefZoneSpatialHash ZoneHash;
+	TArray<TWeakObjectPtr<AAefPharusDeepSyncZoneActor>> HashedZones;
+	TArray<uint64> ZoneOccupancy;
+	TArray<FAefZoneOccupant> OccupancyScratch;
+	bool bZoneLayoutDirty = true;
+
+	void UpdateZoneOccupancy();
+	void RebuildZoneHash();
+
+	//--------------------------------------------------------------------------------
+	// Global Zone Assignment (Internal)
+	//--------------------------------------------------------------------------------
+
+	FAefZoneAssignmentSolver ZoneAssignmentSolver;
+	TArray<AAefPharusDeepSyncZoneActor*> AssignmentZones;
+	TArray<int32> AssignmentTrackIDs;
+	TMap<int32, int32> AssignmentTrackColumns;
+	TArray<int32> AssignmentSyncingTrackIDs;
+	TArray<double> AssignmentCosts;
+	TArray<int32> AssignmentResult;
+
+	void SolveZoneAssignment();
 
 public:
 	//--------------------------------------------------------------------------------
@@ -228,6 +880,26 @@ public:
 	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Sync|Zones")
 	AAefPharusDeepSyncZoneActor* GetZoneByWearableId(int32 InWearableId) const;
 
+	/** Get number of zones with a sync in progress */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Sync|Zones")
+	int32 GetSyncingZoneCount() const;
+
+	/** Rebuild zone detection after zones were moved or resized at runtime (spatial hash mode) */
+	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Sync|Zones")
+	void InvalidateZoneLayout() { bZoneLayoutDirty = true; }
+
+	/** Check if zones are detected via spatial hash instead of overlap events */
+	bool UsesSpatialZoneDetection() const { return Config.ZoneDetectionMode == EAefZoneDetectionMode::SpatialHash; }
+
+	/** Check if free zones take their track from the global assignment instead of deciding locally */
+	bool UsesGlobalZoneAssignment() const { return Config.bGlobalZoneAssignment; }
+
+	/** Add zone to the batched sync update (called by zone when a track enters) */
+	void BeginZoneSession(AAefPharusDeepSyncZoneActor* Zone, AActor* PharusActor);
+
+	/** Remove zone from the batched sync update (called by zone when it is empty and idle) */
+	void EndZoneSession(AAefPharusDeepSyncZoneActor* Zone);
+
 	//--------------------------------------------------------------------------------
 	// Sync Link Management
 	//--------------------------------------------------------------------------------
@@ -252,6 +924,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Sync|Links")
 	AActor* GetPharusActorByWearableId(int32 InWearableId) const;
 
+	/** Get number of lost links waiting for auto-relink */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Sync|Links")
+	int32 GetPendingRelinkCount() const { return LinkTombstones.Num(); }
+
 	//--------------------------------------------------------------------------------
 	// Blocking Checks
 	//--------------------------------------------------------------------------------
@@ -288,10 +964,18 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "AEF|DeepSync|Sync|Events")
 	FAefOnLinkEstablished OnLinkEstablished;
 
-	/** Fired when a link is broken */
+	/** Fired when a link is broken (after the grace window if linkGraceWindow > 0) */
 	UPROPERTY(BlueprintAssignable, Category = "AEF|DeepSync|Sync|Events")
 	FAefOnLinkBroken OnLinkBroken;
 
+	/** Fired when a lost link is restored within the grace window */
+	UPROPERTY(BlueprintAssignable, Category = "AEF|DeepSync|Sync|Events")
+	FAefOnLinkRestored OnLinkRestored;
+
+	/** Fired when a link moved to a new TrackID after the tracker reassigned IDs */
+	UPROPERTY(BlueprintAssignable, Category = "AEF|DeepSync|Sync|Events")
+	FAefOnLinkTrackReassigned OnLinkTrackReassigned;
+
 	/** Fired when a zone is registered */
 	UPROPERTY(BlueprintAssignable, Category = "AEF|DeepSync|Sync|Events")
 	FAefOnZoneRegistered OnZoneRegistered;
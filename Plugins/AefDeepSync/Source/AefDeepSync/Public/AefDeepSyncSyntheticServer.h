@@ -0,0 +1,175 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Synthetic Server
+
+   Stand-in for the deepsyncwearablev2-server. Simulates wearables on
+   the DeepSync ports so the subsystem can be tested and load tested
+   without the real server or devices.
+
+   USAGE:
+   UnrealEditor-Cmd <Project> -run=AefDeepSyncSyntheticServer -Wearables=2000 -Rate=100
+   or in a running game: AefDeepSync.SyntheticServer.Start Wearables=200 Rate=50
+   Point the client at it with deepSyncIp=127.0.0.1
+
+   Development tool, not compiled into Shipping builds.
+========================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Math/RandomStream.h"
+#include "AefDeepSyncEffects.h"
+
+#if !UE_BUILD_SHIPPING
+
+class FSocket;
+class FRunnableThread;
+
+/** Synthetic server settings (all keys can be given as Key=Value on the command line) */
+struct AEFDEEPSYNC_API FAefSyntheticServerSettings
+{
+	/** Port the server streams wearable data on (client's deepSyncReceiverPort) */
+	int32 ReceiverPort = 43397;
+
+	/** Port the server accepts commands on (client's deepSyncSenderPort) */
+	int32 SenderPort = 43396;
+
+	/** Number of simulated wearables (Wearables=) */
+	int32 NumWearables = 16;
+
+	/** WearableId of the first simulated wearable, the rest count up (FirstId=) */
+	int32 FirstWearableId = 1;
+
+	/** Updates per second per wearable (Rate=) */
+	float UpdateRate = 10.0f;
+
+	/** Random delay added to each update in milliseconds (Jitter=) */
+	float JitterMs = 5.0f;
+
+	/** Dropouts per wearable per minute, the wearable goes silent (Dropouts=) */
+	float DropoutsPerMinute = 0.0f;
+
+	/** Seconds a dropped out wearable stays silent (DropoutDuration=) */
+	float DropoutDuration = 3.0f;
+
+	/** Bursts per minute, the stream stalls and then delivers the backlog at once (Bursts=) */
+	float BurstsPerMinute = 0.0f;
+
+	/** Seconds a burst holds back data (BurstDuration=) */
+	float BurstDuration = 0.25f;
+
+	/** Random seed, same seed = same simulation (Seed=) */
+	int32 Seed = 1234;
+
+	/** Read settings from Key=Value pairs */
+	static FAefSyntheticServerSettings Parse(const TCHAR* Params);
+};
+
+/**
+ * Synthetic DeepSync Server
+ *
+ * Runs on its own thread. Wearable frames use the server's JSON format
+ * with 'X' delimiters. Heart rates drift around a per-wearable resting
+ * rate. Color and ID commands are applied to the simulated wearable, so
+ * the change shows up in its following frames. Group color commands
+ * ("Ids") and uploaded LED effects ("type":"effect") are understood too,
+ * effects are played in the frames like a device would. Commands are
+ * also read from data connections, so duplex clients work as well.
+ *
+ * All frames due in a loop iteration are sent with one Send per client.
+ * Clients that stop reading are dropped once their backlog exceeds
+ * MaxClientBacklog.
+ */
+class AEFDEEPSYNC_API FAefDeepSyncSyntheticServer : public FRunnable
+{
+public:
+	FAefDeepSyncSyntheticServer() = default;
+	virtual ~FAefDeepSyncSyntheticServer() override;
+
+	/** Open both listening ports and start the server thread */
+	bool Start(const FAefSyntheticServerSettings& InSettings);
+
+	/** Stop the thread and close all sockets */
+	void Shutdown();
+
+	bool IsRunning() const { return Thread != nullptr; }
+
+	int64 GetFramesSent() const { return FramesSent; }
+	int64 GetBytesSent() const { return BytesSent; }
+	int64 GetCommandsReceived() const { return CommandsReceived; }
+	int32 GetClientCount() const { return ClientCount; }
+
+	/** Stop the server started by the AefDeepSync.SyntheticServer console commands */
+	static void ShutdownConsoleInstance();
+
+	//--------------------------------------------------------------------------------
+	// FRunnable Interface
+	//--------------------------------------------------------------------------------
+
+	virtual uint32 Run() override;
+	virtual void Stop() override { bStopping = true; }
+
+private:
+	struct FSimWearable
+	{
+		int32 WearableId = 0;
+		float HeartRate = 70.0f;
+		float RestingHeartRate = 70.0f;
+		uint8 R = 0;
+		uint8 G = 0;
+		uint8 B = 0;
+		double NextSendTime = 0.0;
+		double SilentUntil = 0.0;
+
+		/** Uploaded LED effect, drives the color while playing */
+		FAefLedEffectState Effect;
+		bool bHasEffect = false;
+	};
+
+	struct FClient
+	{
+		FSocket* Socket = nullptr;
+
+		/** Unsent frames (data clients) */
+		TArray<uint8> Buffer;
+
+		/** Incomplete command (command clients, duplex data clients) */
+		TArray<uint8> CommandBuffer;
+	};
+
+	static constexpr int32 MaxClientBacklog = 16 * 1024 * 1024;
+
+	void AcceptClients(FSocket* Listener, TArray<FClient>& Clients, const TCHAR* Name);
+	int32 GenerateFrames(double Now);
+	void SendFrames();
+	void ReceiveCommands();
+	void ReadCommands(FClient& Client);
+	void ApplyCommand(const FString& JsonCommand);
+	static void CloseClient(FClient& Client);
+
+	FAefSyntheticServerSettings Settings;
+	FRandomStream Random;
+
+	FSocket* DataListener = nullptr;
+	FSocket* CommandListener = nullptr;
+	TArray<FClient> DataClients;
+	TArray<FClient> CommandClients;
+
+	TArray<FSimWearable> Wearables;
+	TArray<uint8> FrameBuffer;
+	int32 PendingFrames = 0;
+	TArray<uint8> ReceiveScratch;
+	double BurstUntil = 0.0;
+	double StartTime = 0.0;
+
+	FRunnableThread* Thread = nullptr;
+	TAtomic<bool> bStopping { false };
+	TAtomic<int64> FramesSent { 0 };
+	TAtomic<int64> BytesSent { 0 };
+	TAtomic<int64> CommandsReceived { 0 };
+	TAtomic<int32> ClientCount { 0 };
+};
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,36 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Synthetic Server Commandlet
+
+   Runs the synthetic DeepSync server headless, e.g. on a second machine
+   or next to a packaged build for load tests.
+
+   USAGE:
+   UnrealEditor-Cmd <Project> -run=AefDeepSyncSyntheticServer -Wearables=2000 -Rate=100 -Duration=600
+
+   Fails in Shipping builds, the server itself is not compiled there.
+========================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AefDeepSyncSyntheticServerCommandlet.generated.h"
+
+/**
+ * Synthetic Server Commandlet
+ *
+ * Accepts all FAefSyntheticServerSettings keys plus Duration= (seconds,
+ * 0 = until the process is stopped). Logs throughput every 5 seconds.
+ */
+UCLASS()
+class AEFDEEPSYNC_API UAefDeepSyncSyntheticServerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAefDeepSyncSyntheticServerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
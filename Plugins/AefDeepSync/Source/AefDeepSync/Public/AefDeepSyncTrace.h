@@ -0,0 +1,72 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Trace
+
+   Unreal Insights trace channel for the wearable message lifecycle.
+
+   USAGE:
+   -trace=default,AefDeepSync            (record with the channel)
+   Trace.Enable AefDeepSync               (enable at runtime)
+========================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+#if !defined(AEFDEEPSYNC_TRACE_ENABLED)
+	#define AEFDEEPSYNC_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+#endif
+
+/** Cycle stamps of one message, only filled in while the channel is enabled */
+struct FAefTraceMessageStages
+{
+	uint64 ReceivedCycle = 0;
+	uint64 FramedCycle = 0;
+	uint64 ParsedCycle = 0;
+};
+
+#if AEFDEEPSYNC_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_EXTERN(AefDeepSyncChannel, AEFDEEPSYNC_API);
+
+/**
+ * Trace output of the plugin
+ *
+ * Every call site checks the channel first (see TRACE_AEFDEEPSYNC),
+ * so a disabled channel costs one branch per message.
+ *
+ * Events of the AefDeepSync logger:
+ * - Receive: bytes read from the socket (or replay) in one chunk
+ * - Message: one wearable message with the cycle stamps of its stages
+ *   (received, framed, parsed, dispatched)
+ *
+ * Heart rates are written as one counter per wearable
+ * (AefDeepSync/HeartRate/<Id>, needs the counters channel). Connection
+ * status changes and link events are written as bookmarks.
+ */
+struct AEFDEEPSYNC_API FAefDeepSyncTrace
+{
+	static void OutputReceive(int32 NumBytes);
+	static void OutputMessage(const FAefTraceMessageStages& Stages, int32 WearableId, int32 ServerTimestamp, int32 NumChars);
+	static void OutputHeartRate(int32 WearableId, int32 HeartRate);
+	static void OutputConnectionStatus(const TCHAR* StatusName);
+	static void OutputLinkEvent(const TCHAR* EventName, int32 LinkId, int32 PharusTrackID, int32 WearableId);
+
+	/** Forget the per-wearable counters (DeepSync stopped) */
+	static void Reset();
+};
+
+#define AEFDEEPSYNC_TRACE_CHANNEL_ENABLED() UE_TRACE_CHANNELEXPR_IS_ENABLED(AefDeepSyncChannel)
+#define TRACE_AEFDEEPSYNC_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, AefDeepSyncChannel)
+#define TRACE_AEFDEEPSYNC(Call) do { if (AEFDEEPSYNC_TRACE_CHANNEL_ENABLED()) { FAefDeepSyncTrace::Call; } } while (0)
+
+#else
+
+#define AEFDEEPSYNC_TRACE_CHANNEL_ENABLED() false
+#define TRACE_AEFDEEPSYNC_SCOPE(Name)
+#define TRACE_AEFDEEPSYNC(Call)
+
+#endif
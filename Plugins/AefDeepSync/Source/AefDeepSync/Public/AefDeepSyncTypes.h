@@ -7,6 +7,7 @@
    - FAefDeepSyncColor: RGB color for wearable LED
    - FAefDeepSyncWearableData: Complete wearable state
    - EAefDeepSyncConnectionStatus: TCP connection state
+   - EAefZoneDetectionMode: How sync zones detect Pharus tracks
    - FAefDeepSyncConfig: Runtime configuration (Blueprint-ready)
 
    See DOCUMENTATION.md for detailed usage examples.
@@ -45,6 +46,16 @@ struct AEFDEEPSYNC_API FAefDeepSyncColor
 
 	FAefDeepSyncColor() = default;
 	FAefDeepSyncColor(uint8 InR, uint8 InG, uint8 InB) : R(InR), G(InG), B(InB) {}
+	explicit FAefDeepSyncColor(const FColor& InColor) : R(InColor.R), G(InColor.G), B(InColor.B) {}
+
+	/** Convert a Blueprint color (0-1 per channel, clamped) */
+	static FAefDeepSyncColor FromLinearColor(const FLinearColor& InColor)
+	{
+		return FAefDeepSyncColor(
+			static_cast<uint8>(FMath::Clamp(InColor.R * 255.0f, 0.0f, 255.0f)),
+			static_cast<uint8>(FMath::Clamp(InColor.G * 255.0f, 0.0f, 255.0f)),
+			static_cast<uint8>(FMath::Clamp(InColor.B * 255.0f, 0.0f, 255.0f)));
+	}
 
 	FLinearColor ToLinearColor() const { return FLinearColor(R / 255.0f, G / 255.0f, B / 255.0f, 1.0f); }
 	FColor ToFColor() const { return FColor(R, G, B, 255); }
@@ -85,6 +96,14 @@ struct AEFDEEPSYNC_API FAefDeepSyncWearableData
 	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Timing")
 	int32 Timestamp = 0;
 
+	/** Server timestamp widened to 64 bit (milliseconds, survives wraparound and server restarts) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Timing")
+	int64 ServerTime = 0;
+
+	/** Delay of the last update above the fastest path to the client in ms (-1 = not measured, see measureLatency) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Timing")
+	float LatencyMs = -1.0f;
+
 	/** Time since last data update (seconds) */
 	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Timing")
 	float TimeSinceLastUpdate = 0.0f;
@@ -116,6 +135,76 @@ enum class EAefDeepSyncConnectionStatus : uint8
 	Failed			UMETA(DisplayName = "Failed")
 };
 
+/**
+ * Sync Zone Detection Mode
+ *
+ * How sync zones find Pharus tracks standing inside them.
+ */
+UENUM(BlueprintType)
+enum class EAefZoneDetectionMode : uint8
+{
+	/** Trigger sphere overlap events (physics scene) */
+	Overlap			UMETA(DisplayName = "Overlap"),
+
+	/** Track positions tested against a spatial hash of zone circles (no physics) */
+	SpatialHash		UMETA(DisplayName = "Spatial Hash")
+};
+
+/**
+ * Command Priority
+ *
+ * Lane of an outbound command (commandLanes=true). Higher lanes are written
+ * first every tick.
+ */
+UENUM(BlueprintType)
+enum class EAefCommandPriority : uint8
+{
+	/** ID changes and safety colors, never held back by the other lanes */
+	Critical		UMETA(DisplayName = "Critical"),
+
+	/** Color commands, group commands and target colors */
+	Normal			UMETA(DisplayName = "Normal"),
+
+	/** Animation colors (LED effects), a newer color for the same wearable replaces a queued one */
+	Background		UMETA(DisplayName = "Background")
+};
+
+/**
+ * Latency Statistics
+ *
+ * Summary of a latency histogram, all values in milliseconds.
+ */
+USTRUCT(BlueprintType)
+struct AEFDEEPSYNC_API FAefDeepSyncLatencyStats
+{
+	GENERATED_BODY()
+
+	/** Number of measured messages */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Latency")
+	int64 SampleCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Latency")
+	float MeanMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Latency")
+	float P50Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Latency")
+	float P95Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Latency")
+	float P99Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Latency")
+	float MaxMs = 0.0f;
+
+	FString ToString() const
+	{
+		return FString::Printf(TEXT("Latency[n=%lld, mean=%.1f, p50=%.0f, p95=%.0f, p99=%.0f, max=%.1f ms]"),
+			SampleCount, MeanMs, P50Ms, P95Ms, P99Ms, MaxMs);
+	}
+};
+
 /**
  * DeepSync Configuration (Blueprint-ready)
  *
@@ -150,6 +239,14 @@ struct AEFDEEPSYNC_API FAefDeepSyncConfig
 	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Connection")
 	int32 SenderPort = 43396;
 
+	/** One TCP connection for data and commands (server must support it) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Connection")
+	bool bDuplexConnection = false;
+
+	/** Port of the duplex connection (0 = ReceiverPort) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Connection")
+	int32 DuplexPort = 0;
+
 	//--------------------------------------------------------------------------------
 	// Wearable Settings
 	//--------------------------------------------------------------------------------
@@ -173,6 +270,201 @@ struct AEFDEEPSYNC_API FAefDeepSyncConfig
 	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Reconnection")
 	int32 MaxReconnectAttempts = 10;
 
+	/** Keep wearables and links untouched across a reconnect, timeouts resume once data flows again */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Reconnection")
+	bool bReconnectGrace = false;
+
+	/** Max seconds after reconnect to wait for the first data before timeouts resume anyway (0 = wait for data) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Reconnection")
+	float ReconnectGraceTimeout = 5.0f;
+
+	/** Send ping commands and, once the server answered one, reconnect when nothing is received for HeartbeatTimeout */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Reconnection")
+	bool bHeartbeat = false;
+
+	/** Seconds between ping commands */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Reconnection")
+	float HeartbeatInterval = 0.5f;
+
+	/** Seconds without any received bytes before the connection counts as dead (half of it: degraded) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Reconnection")
+	float HeartbeatTimeout = 1.5f;
+
+	//--------------------------------------------------------------------------------
+	// Sync Zone Settings
+	//--------------------------------------------------------------------------------
+
+	/** How sync zones detect Pharus tracks */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Zones")
+	EAefZoneDetectionMode ZoneDetectionMode = EAefZoneDetectionMode::Overlap;
+
+	/** Spatial hash cell size in cm (0 = auto from largest zone radius) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Zones")
+	float ZoneHashCellSize = 0.0f;
+
+	/** Assign tracks to free zones in one global min-cost matching per tick (instead of per zone) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Zones")
+	bool bGlobalZoneAssignment = false;
+
+	/** Seconds a link lost by wearable timeout or track loss waits for auto-relink (0 = break immediately) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Zones")
+	float LinkGraceWindow = 0.0f;
+
+	/** Max distance (cm) of a new Pharus track from the last known position to take over a lost link */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Zones")
+	float LinkRelinkRadius = 100.0f;
+
+	/** Seconds a link waits for the tracker to hand its person over to a new TrackID (0 = off) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Zones")
+	float TrackHandoffWindow = 0.0f;
+
+	/** Max distance (cm) between a vanished and a new Pharus track for a TrackID handoff */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Zones")
+	float TrackHandoffRadius = 75.0f;
+
+	//--------------------------------------------------------------------------------
+	// Warm-Start Journal
+	//--------------------------------------------------------------------------------
+
+	/** Journal links and wearable state to disk and restore them after a restart */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Journal")
+	bool bJournalEnabled = false;
+
+	/** Journal file (empty = Saved/AefDeepSync/DeepSync.journal) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Journal")
+	FString JournalFile;
+
+	/** Seconds after the first connect in which journaled links are restored when wearable and track come back */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Journal")
+	float JournalRestoreWindow = 30.0f;
+
+	/** Seconds between wearable snapshots */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Journal")
+	float JournalSnapshotInterval = 5.0f;
+
+	//--------------------------------------------------------------------------------
+	// Capture & Replay
+	//--------------------------------------------------------------------------------
+
+	/** Record the received stream to this file while connected (empty = off) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Capture")
+	FString CaptureFile;
+
+	/** Replay this capture instead of connecting to the server (empty = off) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Capture")
+	FString ReplayFile;
+
+	/** Replay speed factor (1.0 = original timing) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Capture")
+	float ReplaySpeed = 1.0f;
+
+	//--------------------------------------------------------------------------------
+	// Latency
+	//--------------------------------------------------------------------------------
+
+	/** Estimate the server clock and record latency histograms */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Latency")
+	bool bMeasureLatency = false;
+
+	/** Seconds per min-filter window of the clock offset estimate */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Latency")
+	float LatencyOffsetWindow = 10.0f;
+
+	/** Number of windows the offset and drift are fitted over */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Latency")
+	int32 LatencyOffsetWindows = 30;
+
+	/** Measure the time from SendColorCommand until the wearable reports the color */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Latency")
+	bool bProbeColorCommands = false;
+
+	/** Seconds a color command may take to show up before it counts as unconfirmed */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Latency")
+	float ColorProbeTimeout = 2.0f;
+
+	/** Seconds the color command histogram covers (rolling, between one and two windows) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Latency")
+	float ColorProbeWindow = 60.0f;
+
+	//--------------------------------------------------------------------------------
+	// Color Reconciliation
+	//--------------------------------------------------------------------------------
+
+	/** Seconds before a target color is sent again if the wearable does not report it */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Commands")
+	float ColorRetryDelay = 0.5f;
+
+	/** Upper limit of the retry delay, it doubles with every attempt */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Commands")
+	float ColorRetryMaxDelay = 8.0f;
+
+	/** Max target color commands per second over all wearables (0 = unlimited) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Commands")
+	float ColorReconcileRate = 50.0f;
+
+	//--------------------------------------------------------------------------------
+	// Group Commands
+	//--------------------------------------------------------------------------------
+
+	/** Server accepts one color command for many wearables ({"Ids":[..],"Color":{..}}) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Commands")
+	bool bServerGroupCommands = false;
+
+	/** Named wearable groups for group color commands (colorGroups=Stage:1,2,3;Entrance:4,5) */
+	TMap<FName, TArray<int32>> ColorGroups;
+
+	//--------------------------------------------------------------------------------
+	// LED Effects
+	//--------------------------------------------------------------------------------
+
+	/** Evaluations per second of playing LED effects (commands only for changed colors) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Effects")
+	float EffectCommandRate = 20.0f;
+
+	/** Server plays effects itself, upload the description once instead of streaming colors */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Effects")
+	bool bServerEffects = false;
+
+	//--------------------------------------------------------------------------------
+	// Command Lanes
+	//--------------------------------------------------------------------------------
+
+	/** Queue commands per priority and write them once per tick, higher priorities first */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Commands")
+	bool bCommandLanes = false;
+
+	/** Critical commands written per tick (0 = unlimited) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Commands")
+	int32 CriticalCommandBudget = 0;
+
+	/** Normal commands written per tick (0 = unlimited) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Commands")
+	int32 NormalCommandBudget = 64;
+
+	/** Background commands written per tick (0 = unlimited) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Commands")
+	int32 BackgroundCommandBudget = 32;
+
+	//--------------------------------------------------------------------------------
+	// ID Provisioning
+	//--------------------------------------------------------------------------------
+
+	/** ID commands of a provisioning job waiting for confirmation at the same time */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Commands")
+	int32 IdProvisioningInFlight = 8;
+
+	/** Seconds to wait for a confirmation before the ID command is sent again */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Commands")
+	float IdProvisioningTimeout = 3.0f;
+
+	/** Retries per wearable before its ID change counts as failed */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Commands")
+	int32 IdProvisioningRetries = 2;
+
+	/** Seconds the old ID must stay silent after the new ID appeared */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Commands")
+	float IdProvisioningConfirmTime = 0.5f;
+
 	//--------------------------------------------------------------------------------
 	// Logging Flags
 	//--------------------------------------------------------------------------------
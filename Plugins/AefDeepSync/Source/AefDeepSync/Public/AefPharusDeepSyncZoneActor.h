@@ -36,6 +36,10 @@ class UAefPharusSubsystem;
  * is linked to the configured WearableId.
  *
  * 1:1:1 Mapping: 1 Zone = 1 WearableId = 1 Person at a time
+ *
+ * Further tracks standing in the zone wait as candidates and accumulate
+ * presence time. If the syncing person leaves, the next candidate
+ * (picked by ArbitrationPolicy) takes over without starting from zero.
  */
 UCLASS(Blueprintable, meta = (DisplayName = "AEF Pharus DeepSync Zone"))
 class AEFDEEPSYNC_API AAefPharusDeepSyncZoneActor : public AActor
@@ -65,6 +69,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AEF|DeepSync|Zone", meta = (ClampMin = "10.0"))
 	float ZoneRadius = 100.0f;
 
+	/** How the syncing track is picked when several tracks stand in the zone */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AEF|DeepSync|Zone")
+	EAefZoneArbitrationPolicy ArbitrationPolicy = EAefZoneArbitrationPolicy::LongestPresence;
+
 	/** Automatically activate zone on BeginPlay */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AEF|DeepSync|Zone")
 	bool bAutoActivate = true;
@@ -97,6 +105,10 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AEF|DeepSync|Zone|Status")
 	bool bIsActive = false;
 
+	/** All Pharus tracks currently in the zone (including the syncing one) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AEF|DeepSync|Zone|Status")
+	TArray<FAefZoneSyncCandidate> SyncCandidates;
+
 	//--------------------------------------------------------------------------------
 	// Events
 	//--------------------------------------------------------------------------------
@@ -137,7 +149,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Zone")
 	void DeactivateZone();
 
-	/** Cancel any ongoing sync */
+	/** Cancel any ongoing sync (the next candidate in the zone takes over) */
 	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Zone")
 	void CancelSync();
 
@@ -149,6 +161,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Zone")
 	bool IsSyncing() const { return bIsSyncing; }
 
+	/** Get number of Pharus tracks in the zone */
+	UFUNCTION(BlueprintPure, Category = "AEF|DeepSync|Zone")
+	int32 GetSyncCandidateCount() const { return SyncCandidates.Num(); }
+
 	/** Update zone color at runtime */
 	UFUNCTION(BlueprintCallable, Category = "AEF|DeepSync|Zone")
 	void SetZoneColor(FLinearColor NewColor);
@@ -160,7 +176,6 @@ protected:
 
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
-	virtual void Tick(float DeltaTime) override;
 	virtual void OnConstruction(const FTransform& Transform) override;
 
 #if WITH_EDITOR
@@ -171,7 +186,7 @@ protected:
 	// Components
 	//--------------------------------------------------------------------------------
 
-	/** Trigger sphere for overlap detection */
+	/** Trigger sphere for overlap detection (radius source in spatial hash mode) */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	TObjectPtr<USphereComponent> TriggerSphere;
 
@@ -180,6 +195,10 @@ protected:
 	TObjectPtr<UStaticMeshComponent> ZoneMesh;
 
 private:
+	/** Subsystem advances running syncs in one batched update (benchmarks drive it directly) */
+	friend class UAefDeepSyncSubsystem;
+	friend class FAefDeepSyncBenchmarks;
+
 	//--------------------------------------------------------------------------------
 	// Internal State
 	//--------------------------------------------------------------------------------
@@ -192,12 +211,18 @@ private:
 	TWeakObjectPtr<UAefDeepSyncSubsystem> DeepSyncSubsystem;
 	TWeakObjectPtr<UAefPharusSubsystem> PharusSubsystem;
 
-	/** Sync timer */
+	/** Sync timer (presence time of the syncing candidate) */
 	float SyncElapsedTime = 0.0f;
 
-	/** Actor currently in zone (for validation) */
+	/** Actor currently syncing (for validation) */
 	TWeakObjectPtr<AActor> OverlappingActor;
 
+	/** Track picked for this zone by the subsystem's global assignment (-1 = none) */
+	int32 AssignedTrackID = -1;
+
+	/** Trigger sphere overlaps are used (false when the subsystem uses spatial hash detection) */
+	bool bUseOverlapDetection = true;
+
 	//--------------------------------------------------------------------------------
 	// Overlap Handlers
 	//--------------------------------------------------------------------------------
@@ -216,11 +241,31 @@ private:
 
 	void SetupComponents();
 	void UpdateMaterialColor();
-	void StartSync(int32 TrackID, AActor* PharusActor);
+	bool StartSync(int32 TrackID, AActor* PharusActor, float InitialElapsedTime, bool bQuiet);
 	void CompleteSync();
 	void FailSync(EAefPharusSyncStatus Status, const FString& Error);
+	void ResetSyncState();
+	void UpdateSyncProgress();
+	void HandleSyncWearableLost();
+	void HandleSyncPharusTrackLost();
+	void NotifyPharusActorEntered(AActor* PharusActor);
+	void NotifyPharusTrackLeft(int32 TrackID);
+	void HandlePharusActorRemoved(AActor* PharusActor);
+	void ApplyZoneDetectionMode(bool bSpatialDetection);
 	bool ValidatePharusActor(AActor* Actor, int32& OutTrackID);
 	UAefDeepSyncSubsystem* GetDeepSyncSubsystem();
 	UAefPharusSubsystem* GetPharusSubsystem();
+
+	//--------------------------------------------------------------------------------
+	// Sync Candidates
+	//--------------------------------------------------------------------------------
+
+	void AdvanceSyncCandidates(float DeltaTime);
+	void ArbitrateSync(bool bQuiet);
+	int32 FindBestCandidateIndex();
+	int32 FindCandidateIndex(int32 TrackID) const;
+	int32 FindCandidateIndex(const AActor* PharusActor) const;
+	void RemoveCandidateAt(int32 Index);
+	void EndSessionIfIdle();
 };
 
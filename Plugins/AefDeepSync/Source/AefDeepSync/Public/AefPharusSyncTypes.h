@@ -39,10 +39,52 @@ enum class EAefPharusSyncStatus : uint8
 	Timeout		UMETA(DisplayName = "Timeout")
 };
 
+/**
+ * How a zone picks the track to sync when several tracks stand inside it
+ */
+UENUM(BlueprintType)
+enum class EAefZoneArbitrationPolicy : uint8
+{
+	/** Track with the longest continuous presence in the zone */
+	LongestPresence		UMETA(DisplayName = "Longest Presence"),
+
+	/** Track closest to the zone center */
+	NearestToCenter		UMETA(DisplayName = "Nearest To Center")
+};
+
 //--------------------------------------------------------------------------------
 // DATA STRUCTURES
 //--------------------------------------------------------------------------------
 
+/**
+ * Pharus track standing inside a sync zone
+ *
+ * Every track in a zone accumulates presence time, not only the one
+ * currently syncing. When a sync is cancelled, the next candidate takes
+ * over with its accumulated presence instead of starting from zero.
+ */
+USTRUCT(BlueprintType)
+struct AEFDEEPSYNC_API FAefZoneSyncCandidate
+{
+	GENERATED_BODY()
+
+	/** Pharus track ID */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Sync|Zone")
+	int32 TrackID = -1;
+
+	/** Seconds of continuous presence in the zone */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Sync|Zone")
+	float PresenceTime = 0.0f;
+
+	/** Sync of this track was cancelled - not picked again until it re-enters */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Sync|Zone")
+	bool bSyncCancelled = false;
+
+	/** The Pharus actor */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Sync|Zone")
+	TWeakObjectPtr<AActor> PharusActor;
+};
+
 /**
  * Result of a Pharus-DeepSync synchronization
  * 
@@ -229,6 +271,10 @@ struct AEFDEEPSYNC_API FAefSyncedLink
 	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Sync|Link")
 	FDateTime SyncTime;
 
+	/** Last known position of the Pharus actor (used for auto-relink) */
+	UPROPERTY(BlueprintReadOnly, Category = "AEF|DeepSync|Sync|Link")
+	FVector LastPharusPosition = FVector::ZeroVector;
+
 	/** Is this link still valid? */
 	bool IsValid() const
 	{
@@ -248,6 +294,12 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAefOnLinkEstablished, const FAefSyn
 /** Fired when a link is broken (lost/manual disconnect) */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAefOnLinkBroken, const FAefSyncedLink&, Link, const FString&, Reason);
 
+/** Fired when a lost link is restored within the grace window */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAefOnLinkRestored, const FAefSyncedLink&, Link);
+
+/** Fired when the tracker gave a linked person a new TrackID and the link followed */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAefOnLinkTrackReassigned, const FAefSyncedLink&, Link, int32, OldPharusTrackID);
+
 /** Fired when a zone is registered with the subsystem */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAefOnZoneRegistered, AAefPharusDeepSyncZoneActor*, Zone);
 
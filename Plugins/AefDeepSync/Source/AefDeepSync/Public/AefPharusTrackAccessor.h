@@ -0,0 +1,40 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Pharus Track Accessor
+
+   Resolves the Pharus TrackID of an actor spawned by the AefPharus
+   plugin. Shared by sync zones and the subsystem's track registry.
+
+   The TrackID source is looked up once per UClass and cached:
+   1. IAefPharusTrackIdProvider (native, no reflection)
+   2. Int property "TrackID" (read via cached offset)
+   3. Function "GetTrackID" (ProcessEvent, slowest)
+========================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+/**
+ * Pharus Track Accessor
+ *
+ * Static helpers to identify Pharus actors (IAefPharusActorInterface or
+ * IAefPharusTrackIdProvider) and read their TrackID. Game thread only.
+ */
+struct AEFDEEPSYNC_API FAefPharusTrackAccessor
+{
+	/** Check if actor is a Pharus actor */
+	static bool IsPharusActor(const AActor* Actor);
+
+	/**
+	 * Read the TrackID of a Pharus actor
+	 * @return False if actor is not a Pharus actor or has no valid TrackID
+	 */
+	static bool GetTrackID(AActor* Actor, int32& OutTrackID);
+
+	/** Drop all cached per-class lookups */
+	static void ResetCache();
+};
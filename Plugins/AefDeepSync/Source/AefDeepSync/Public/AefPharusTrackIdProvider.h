@@ -0,0 +1,37 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Pharus TrackID Provider Interface
+
+   Optional native interface for Pharus actor classes. Implementing it
+   lets sync zones read the TrackID with a plain virtual call instead
+   of the reflected TrackID property / GetTrackID() function.
+========================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "AefPharusTrackIdProvider.generated.h"
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UAefPharusTrackIdProvider : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Pharus TrackID Provider
+ *
+ * Implement in C++ Pharus actor subclasses:
+ *   class AMyPharusActor : public AAefPharusActor, public IAefPharusTrackIdProvider
+ *   virtual int32 GetPharusTrackID() const override { return TrackID; }
+ */
+class AEFDEEPSYNC_API IAefPharusTrackIdProvider
+{
+	GENERATED_BODY()
+
+public:
+	/** Current Pharus TrackID of this actor (-1 = none) */
+	virtual int32 GetPharusTrackID() const = 0;
+};
@@ -0,0 +1,49 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Zone Assignment Solver
+
+   Minimum-cost bipartite assignment (Hungarian method) between
+   contending sync zones and Pharus tracks.
+========================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Zone Assignment Solver
+ *
+ * Rows are zones, columns are tracks. Every row gets at most one column
+ * and every column at most one row. As many rows as possible are matched,
+ * among those matchings the one with the smallest summed cost wins.
+ * Pairs that must not be matched use ForbiddenCost and are reported as
+ * unassigned. Scratch buffers are kept between solves, so a solver that
+ * lives in the subsystem does not allocate in steady state.
+ *
+ * O(Rows^2 * Cols) - about 0.5M steps for 50 zones x 200 tracks.
+ */
+class AEFDEEPSYNC_API FAefZoneAssignmentSolver
+{
+public:
+	/** Cost of a pair that must never be matched */
+	static constexpr double ForbiddenCost = 1.0e9;
+
+	/**
+	 * Solve the assignment
+	 * @param Costs Row-major cost matrix, NumRows x NumCols
+	 * @param NumRows Number of zones
+	 * @param NumCols Number of tracks
+	 * @param OutColumnForRow Assigned column per row (INDEX_NONE = unassigned)
+	 * @return Summed cost of all assigned pairs
+	 */
+	double Solve(TConstArrayView<double> Costs, int32 NumRows, int32 NumCols, TArray<int32>& OutColumnForRow);
+
+private:
+	TArray<double> RowPotential;
+	TArray<double> ColPotential;
+	TArray<double> MinSlack;
+	TArray<int32> RowForCol;
+	TArray<int32> PrevCol;
+	TArray<bool> ColUsed;
+};
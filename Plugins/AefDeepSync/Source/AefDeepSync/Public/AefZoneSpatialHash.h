@@ -0,0 +1,87 @@
+/*========================================================================
+   Copyright (c) Ars Electronica Futurelab, 2025
+
+   AefDeepSync - Zone Spatial Hash
+
+   Uniform grid over sync zone circles (floor plane) for physics-free
+   zone occupancy detection from Pharus track positions.
+========================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Zone Spatial Hash
+ *
+ * Every zone circle is inserted into all grid cells its bounds touch,
+ * so a point query only visits the zones of a single cell.
+ * Build once when the zone layout changes, query every tick.
+ */
+class AEFDEEPSYNC_API FAefZoneSpatialHash
+{
+public:
+	/**
+	 * Rebuild the hash from zone circles
+	 * @param Centers Zone centers (world XY)
+	 * @param Radii Zone radii (cm), same count as Centers
+	 * @param InCellSize Grid cell size (cm), <= 0 uses twice the largest radius
+	 */
+	void Build(TConstArrayView<FVector2D> Centers, TConstArrayView<float> Radii, float InCellSize = 0.0f);
+
+	/** Remove all zones */
+	void Reset();
+
+	/** Number of zones in the hash */
+	int32 NumZones() const { return Circles.Num(); }
+
+	/** Grid cell size in use (cm) */
+	float GetCellSize() const { return CellSize; }
+
+	/** Call Visit(ZoneIndex) for every zone circle containing Point */
+	template <typename FuncType>
+	void ForEachZoneAt(const FVector2D& Point, FuncType&& Visit) const
+	{
+		const int32* CellIndex = CellLookup.Find(ToCell(Point));
+		if (!CellIndex)
+		{
+			return;
+		}
+
+		const FCell& Cell = Cells[*CellIndex];
+		for (int32 i = Cell.First; i < Cell.First + Cell.Num; ++i)
+		{
+			const int32 ZoneIndex = CellZones[i];
+			const FCircle& Circle = Circles[ZoneIndex];
+			if (FVector2D::DistSquared(Point, Circle.Center) <= Circle.RadiusSq)
+			{
+				Visit(ZoneIndex);
+			}
+		}
+	}
+
+private:
+	struct FCircle
+	{
+		FVector2D Center = FVector2D::ZeroVector;
+		double RadiusSq = 0.0;
+	};
+
+	struct FCell
+	{
+		int32 First = 0;
+		int32 Num = 0;
+	};
+
+	FIntPoint ToCell(const FVector2D& Point) const
+	{
+		return FIntPoint(FMath::FloorToInt32(Point.X * InvCellSize), FMath::FloorToInt32(Point.Y * InvCellSize));
+	}
+
+	TArray<FCircle> Circles;
+	TArray<FCell> Cells;
+	TArray<int32> CellZones;
+	TMap<FIntPoint, int32> CellLookup;
+	float CellSize = 200.0f;
+	float InvCellSize = 1.0f / 200.0f;
+};